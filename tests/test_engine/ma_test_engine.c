@@ -0,0 +1,130 @@
+#define MA_NO_DEVICE_IO
+#include "../test_common/ma_test_common.c"
+
+/*
+Helpers shared by the engine tests. The engine is run without a device and read with ma_engine_read_pcm_frames() so the tests control
+exactly when the audio thread's work happens. Sounds play from in-memory buffers so nothing is loaded from disk.
+*/
+#define TEST_ENGINE_CHANNELS    2
+#define TEST_ENGINE_SAMPLE_RATE 48000
+
+static ma_result test_engine__init(const ma_allocation_callbacks* pAllocationCallbacks, ma_engine* pEngine)
+{
+    ma_engine_config engineConfig;
+
+    engineConfig = ma_engine_config_init();
+    engineConfig.noDevice   = MA_TRUE;
+    engineConfig.channels   = TEST_ENGINE_CHANNELS;
+    engineConfig.sampleRate = TEST_ENGINE_SAMPLE_RATE;
+
+    if (pAllocationCallbacks != NULL) {
+        engineConfig.allocationCallbacks = *pAllocationCallbacks;
+    }
+
+    return ma_engine_init(&engineConfig, pEngine);
+}
+
+/* A mono buffer where every sample is the same value, so anything that reaches the output is easy to pick out. */
+static ma_result test_engine__init_constant_buffer(float value, ma_uint64 frameCount, ma_audio_buffer* pAudioBuffer)
+{
+    ma_result result;
+    ma_audio_buffer_config audioBufferConfig;
+    float* pFrames;
+    ma_uint64 iFrame;
+
+    pFrames = (float*)ma_malloc((size_t)(frameCount * sizeof(float)), NULL);
+    if (pFrames == NULL) {
+        return MA_OUT_OF_MEMORY;
+    }
+
+    for (iFrame = 0; iFrame < frameCount; iFrame += 1) {
+        pFrames[iFrame] = value;
+    }
+
+    audioBufferConfig = ma_audio_buffer_config_init(ma_format_f32, 1, frameCount, pFrames, NULL);
+    result = ma_audio_buffer_init_copy(&audioBufferConfig, pAudioBuffer);
+
+    ma_free(pFrames, NULL);
+
+    return result;
+}
+
+/* The number of frames in an interleaved engine output block that aren't silent. */
+static ma_uint64 test_engine__count_audible_frames(const float* pFrames, ma_uint64 frameCount)
+{
+    ma_uint64 audibleFrameCount = 0;
+    ma_uint64 iFrame;
+    ma_uint32 iChannel;
+
+    for (iFrame = 0; iFrame < frameCount; iFrame += 1) {
+        for (iChannel = 0; iChannel < TEST_ENGINE_CHANNELS; iChannel += 1) {
+            if (pFrames[iFrame*TEST_ENGINE_CHANNELS + iChannel] > 1e-4f || pFrames[iFrame*TEST_ENGINE_CHANNELS + iChannel] < -1e-4f) {
+                audibleFrameCount += 1;
+                break;
+            }
+        }
+    }
+
+    return audibleFrameCount;
+}
+
+static ma_result test_engine__report(const char* pErrorMessage)
+{
+    if (pErrorMessage != NULL) {
+        printf("    %s\n", pErrorMessage);
+        return MA_ERROR;
+    }
+
+    return MA_SUCCESS;
+}
+
+#include "ma_test_engine_command_buffer.c"
+#include "ma_test_engine_sound_pool.c"
+#include "ma_test_engine_metering.c"
+#include "ma_test_engine_gain_pan.c"
+
+int main(int argc, char** argv)
+{
+    ma_result result;
+    ma_bool32 hasError = MA_FALSE;
+    size_t iTest;
+
+    (void)argc;
+    (void)argv;
+
+    result = ma_register_test("Command Buffer", test_entry__engine_command_buffer);
+    if (result != MA_SUCCESS) {
+        return result;
+    }
+
+    result = ma_register_test("Sound Pool", test_entry__engine_sound_pool);
+    if (result != MA_SUCCESS) {
+        return result;
+    }
+
+    result = ma_register_test("Metering", test_entry__engine_metering);
+    if (result != MA_SUCCESS) {
+        return result;
+    }
+
+    result = ma_register_test("Gain and Pan", test_entry__engine_gain_pan);
+    if (result != MA_SUCCESS) {
+        return result;
+    }
+
+    for (iTest = 0; iTest < g_Tests.count; iTest += 1) {
+        printf("=== BEGIN %s ===\n", g_Tests.pTests[iTest].pName);
+        result = g_Tests.pTests[iTest].onEntry(argc, argv);
+        printf("=== END %s : %s ===\n", g_Tests.pTests[iTest].pName, (result == 0) ? "PASSED" : "FAILED");
+
+        if (result != 0) {
+            hasError = MA_TRUE;
+        }
+    }
+
+    if (hasError) {
+        return -1;  /* Something failed. */
+    } else {
+        return 0;   /* Everything passed. */
+    }
+}
@@ -0,0 +1,127 @@
+/* A start recorded into a command buffer must restart a finished sound regardless of whether it finished before or after the recording. */
+#define COMMAND_BUFFER_TEST_SOUND_LENGTH    100
+#define COMMAND_BUFFER_TEST_BLOCK_SIZE      256
+
+static ma_uint64 test_command_buffer__read_block(ma_engine* pEngine)
+{
+    float frames[COMMAND_BUFFER_TEST_BLOCK_SIZE * TEST_ENGINE_CHANNELS];
+    ma_uint64 framesRead;
+
+    if (ma_engine_read_pcm_frames(pEngine, frames, COMMAND_BUFFER_TEST_BLOCK_SIZE, &framesRead) != MA_SUCCESS) {
+        return 0;
+    }
+
+    return test_engine__count_audible_frames(frames, framesRead);
+}
+
+int test_entry__engine_command_buffer(int argc, char** argv)
+{
+    ma_engine engine;
+    ma_audio_buffer audioBuffer;
+    ma_sound sound;
+    ma_engine_command_buffer commandBuffer;
+    ma_uint64 cursor;
+    const char* pErrorMessage = NULL;
+
+    (void)argc;
+    (void)argv;
+
+    if (test_engine__init(NULL, &engine) != MA_SUCCESS) {
+        printf("    Failed to initialize the engine.\n");
+        return -1;
+    }
+
+    if (test_engine__init_constant_buffer(0.5f, COMMAND_BUFFER_TEST_SOUND_LENGTH, &audioBuffer) != MA_SUCCESS) {
+        printf("    Failed to initialize the audio buffer.\n");
+        ma_engine_uninit(&engine);
+        return -1;
+    }
+
+    if (ma_sound_init_from_data_source(&engine, &audioBuffer, MA_SOUND_FLAG_NO_SPATIALIZATION | MA_SOUND_FLAG_NO_PITCH, NULL, &sound) != MA_SUCCESS) {
+        printf("    Failed to initialize the sound.\n");
+        ma_audio_buffer_uninit(&audioBuffer);
+        ma_engine_uninit(&engine);
+        return -1;
+    }
+
+    if (ma_engine_command_buffer_init(16, NULL, NULL, &commandBuffer) != MA_SUCCESS) {
+        printf("    Failed to initialize the command buffer.\n");
+        ma_sound_uninit(&sound);
+        ma_audio_buffer_uninit(&audioBuffer);
+        ma_engine_uninit(&engine);
+        return -1;
+    }
+
+    /* Recorded while the sound is still at the start, then submitted after it has played to the end. */
+    ma_engine_command_buffer_sound_start(&commandBuffer, &sound);
+    ma_sound_start(&sound);
+
+    if (test_command_buffer__read_block(&engine) != COMMAND_BUFFER_TEST_SOUND_LENGTH) {
+        pErrorMessage = "The sound did not play.";
+        goto done;
+    }
+
+    if (test_command_buffer__read_block(&engine) != 0 || ma_sound_is_playing(&sound) || !ma_sound_at_end(&sound)) {
+        pErrorMessage = "The sound did not stop at the end.";
+        goto done;
+    }
+
+    if (ma_engine_submit_command_buffer(&engine, &commandBuffer) != MA_SUCCESS) {
+        pErrorMessage = "Failed to submit the command buffer.";
+        goto done;
+    }
+
+    /* Seeking is left to the sound's processing, so nothing has moved yet. */
+    ma_audio_buffer_get_cursor_in_pcm_frames(&audioBuffer, &cursor);
+    if (cursor != COMMAND_BUFFER_TEST_SOUND_LENGTH) {
+        pErrorMessage = "The data source was seeked outside of the audio thread.";
+        goto done;
+    }
+
+    if (test_command_buffer__read_block(&engine) != COMMAND_BUFFER_TEST_SOUND_LENGTH || ma_engine_command_buffer_is_pending(&commandBuffer)) {
+        pErrorMessage = "A start recorded before the sound finished did not restart it.";
+        goto done;
+    }
+
+    /* The same buffer reset and recorded again now that the sound has finished again. */
+    if (ma_engine_command_buffer_reset(&commandBuffer) != MA_SUCCESS || ma_engine_command_buffer_get_count(&commandBuffer) != 0) {
+        pErrorMessage = "Failed to reset the command buffer.";
+        goto done;
+    }
+
+    ma_engine_command_buffer_sound_start(&commandBuffer, &sound);
+
+    if (!ma_sound_at_end(&sound) || ma_engine_submit_command_buffer(&engine, &commandBuffer) != MA_SUCCESS) {
+        pErrorMessage = "Failed to submit the command buffer.";
+        goto done;
+    }
+
+    if (test_command_buffer__read_block(&engine) != COMMAND_BUFFER_TEST_SOUND_LENGTH) {
+        pErrorMessage = "A start recorded after the sound finished did not restart it.";
+        goto done;
+    }
+
+    /* A seek made before the start is applied takes precedence over the rewind, like with ma_sound_start(). */
+    ma_sound_seek_to_pcm_frame(&sound, COMMAND_BUFFER_TEST_SOUND_LENGTH/2);
+    ma_engine_command_buffer_reset(&commandBuffer);
+    ma_engine_command_buffer_sound_start(&commandBuffer, &sound);
+    ma_engine_submit_command_buffer(&engine, &commandBuffer);
+
+    if (test_command_buffer__read_block(&engine) != COMMAND_BUFFER_TEST_SOUND_LENGTH/2) {
+        pErrorMessage = "A pending seek was overridden by the rewind.";
+        goto done;
+    }
+
+done:
+    ma_engine_command_buffer_reset(&commandBuffer);
+    ma_sound_uninit(&sound);
+    ma_engine_uninit(&engine);
+    ma_engine_command_buffer_uninit(&commandBuffer);
+    ma_audio_buffer_uninit(&audioBuffer);
+
+    if (test_engine__report(pErrorMessage) != MA_SUCCESS) {
+        return -1;
+    }
+
+    return 0;
+}
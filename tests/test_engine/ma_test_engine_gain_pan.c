@@ -0,0 +1,225 @@
+/*
+Without spatialization, a sound's fade, volume and pan are all applied to each frame in a single pass. The output has to match doing
+them one after the other: the fade, then the volume, then the pan. The reference here does exactly that, one sample at a time. Blocks
+are read at an awkward size so fades and volume ramps begin and end part way through a block.
+*/
+#define GAIN_PAN_TEST_SOUND_LENGTH  4800
+#define GAIN_PAN_TEST_BLOCK_SIZE    333
+#define GAIN_PAN_TEST_TOLERANCE     0.00001f
+
+typedef struct
+{
+    ma_pan_mode panMode;
+    float pan;
+    float volume;
+    float fadeVolumeBeg;
+    float fadeVolumeEnd;
+    ma_uint32 fadeLengthInFrames;       /* 0 for no fade. */
+    ma_uint32 volumeSmoothTimeInFrames; /* 0 for no smoothing. */
+    float newVolume;
+    ma_uint32 newVolumeBlock;           /* The volume is changed to newVolume before reading this block. 0 to leave the volume alone. */
+} test_gain_pan_case;
+
+/* Each channel gets different content so any mix up between them shows. */
+static ma_result test_gain_pan__init_buffer(float* pFrames, ma_audio_buffer* pAudioBuffer)
+{
+    ma_audio_buffer_config audioBufferConfig;
+    ma_uint32 iFrame;
+
+    for (iFrame = 0; iFrame < GAIN_PAN_TEST_SOUND_LENGTH; iFrame += 1) {
+        pFrames[iFrame*2 + 0] = (float)(0.5 * ma_sind(iFrame * 0.01));
+        pFrames[iFrame*2 + 1] = (float)(0.5 * ma_cosd(iFrame * 0.013));
+    }
+
+    audioBufferConfig = ma_audio_buffer_config_init(ma_format_f32, 2, GAIN_PAN_TEST_SOUND_LENGTH, pFrames, NULL);
+    return ma_audio_buffer_init(&audioBufferConfig, pAudioBuffer);
+}
+
+static float test_gain_pan__ramp(float beg, float end, ma_uint32 cursor, ma_uint32 length)
+{
+    if (cursor >= length) {
+        return end;
+    }
+
+    return beg + (end - beg) * ((float)cursor / length);
+}
+
+static void test_gain_pan__calculate_expected_frame(const test_gain_pan_case* pCase, const float* pFrameIn, ma_uint32 iFrame, float* pFrameOut)
+{
+    float sample[2];
+    float volume;
+    ma_uint32 newVolumeFrame = pCase->newVolumeBlock * GAIN_PAN_TEST_BLOCK_SIZE;
+    double theta;
+
+    sample[0] = pFrameIn[0];
+    sample[1] = pFrameIn[1];
+
+    /* Fade. */
+    if (pCase->fadeLengthInFrames > 0) {
+        float fade = test_gain_pan__ramp(pCase->fadeVolumeBeg, pCase->fadeVolumeEnd, iFrame, pCase->fadeLengthInFrames);
+        sample[0] *= fade;
+        sample[1] *= fade;
+    }
+
+    /* Volume. */
+    volume = pCase->volume;
+    if (pCase->newVolumeBlock > 0 && iFrame >= newVolumeFrame) {
+        if (pCase->volumeSmoothTimeInFrames > 0) {
+            volume = test_gain_pan__ramp(pCase->volume, pCase->newVolume, iFrame - newVolumeFrame, pCase->volumeSmoothTimeInFrames);
+        } else {
+            volume = pCase->newVolume;
+        }
+    }
+
+    sample[0] *= volume;
+    sample[1] *= volume;
+
+    /* Pan. */
+    if (pCase->panMode == ma_pan_mode_constant_power) {
+        theta = (pCase->pan + 1) * (MA_PI_D / 4);
+        sample[0] *= (float)(ma_cosd(theta) * ma_sqrtd(2));
+        sample[1] *= (float)(ma_sind(theta) * ma_sqrtd(2));
+    } else {
+        if (pCase->pan > 0) {
+            sample[0] *= 1 - pCase->pan;
+        } else {
+            sample[1] *= 1 + pCase->pan;
+        }
+    }
+
+    pFrameOut[0] = sample[0];
+    pFrameOut[1] = sample[1];
+}
+
+static ma_result test_gain_pan__run(const test_gain_pan_case* pCase)
+{
+    ma_engine engine;
+    float* pFramesIn;
+    ma_audio_buffer audioBuffer;
+    ma_sound_config soundConfig;
+    ma_sound sound;
+    float framesOut[GAIN_PAN_TEST_BLOCK_SIZE * TEST_ENGINE_CHANNELS];
+    float expectedFrame[2];
+    ma_uint64 framesRead;
+    ma_uint32 totalFramesRead = 0;
+    ma_uint32 iBlock;
+    ma_uint32 iFrame;
+    ma_uint32 iChannel;
+    const char* pErrorMessage = NULL;
+
+    printf("    %s %.2f, volume %.2f", (pCase->panMode == ma_pan_mode_constant_power) ? "Constant power pan" : "Balance", pCase->pan, pCase->volume);
+    if (pCase->fadeLengthInFrames > 0) {
+        printf(", fade %.2f to %.2f over %u frames", pCase->fadeVolumeBeg, pCase->fadeVolumeEnd, pCase->fadeLengthInFrames);
+    }
+    if (pCase->newVolumeBlock > 0) {
+        printf(", volume to %.2f over %u frames", pCase->newVolume, pCase->volumeSmoothTimeInFrames);
+    }
+    printf("\n");
+
+    if (test_engine__init(NULL, &engine) != MA_SUCCESS) {
+        printf("    Failed to initialize the engine.\n");
+        return MA_ERROR;
+    }
+
+    pFramesIn = (float*)ma_malloc(GAIN_PAN_TEST_SOUND_LENGTH * 2 * sizeof(float), NULL);
+    if (pFramesIn == NULL) {
+        ma_engine_uninit(&engine);
+        return MA_OUT_OF_MEMORY;
+    }
+
+    if (test_gain_pan__init_buffer(pFramesIn, &audioBuffer) != MA_SUCCESS) {
+        printf("    Failed to initialize the audio buffer.\n");
+        ma_free(pFramesIn, NULL);
+        ma_engine_uninit(&engine);
+        return MA_ERROR;
+    }
+
+    soundConfig = ma_sound_config_init_2(&engine);
+    soundConfig.pDataSource                 = &audioBuffer;
+    soundConfig.flags                       = MA_SOUND_FLAG_NO_SPATIALIZATION | MA_SOUND_FLAG_NO_PITCH;
+    soundConfig.volumeSmoothTimeInPCMFrames = pCase->volumeSmoothTimeInFrames;
+
+    if (ma_sound_init_ex(&engine, &soundConfig, &sound) != MA_SUCCESS) {
+        printf("    Failed to initialize the sound.\n");
+        ma_audio_buffer_uninit(&audioBuffer);
+        ma_free(pFramesIn, NULL);
+        ma_engine_uninit(&engine);
+        return MA_ERROR;
+    }
+
+    /* Nothing has been processed yet so the initial volume is applied straight away rather than being smoothed. */
+    ma_sound_set_volume(&sound, pCase->volume);
+    ma_sound_set_pan_mode(&sound, pCase->panMode);
+    ma_sound_set_pan(&sound, pCase->pan);
+
+    if (pCase->fadeLengthInFrames > 0) {
+        ma_sound_set_fade_in_pcm_frames(&sound, pCase->fadeVolumeBeg, pCase->fadeVolumeEnd, pCase->fadeLengthInFrames);
+    }
+
+    ma_sound_start(&sound);
+
+    for (iBlock = 0; totalFramesRead + GAIN_PAN_TEST_BLOCK_SIZE <= GAIN_PAN_TEST_SOUND_LENGTH; iBlock += 1) {
+        if (pCase->newVolumeBlock > 0 && iBlock == pCase->newVolumeBlock) {
+            ma_sound_set_volume(&sound, pCase->newVolume);
+        }
+
+        if (ma_engine_read_pcm_frames(&engine, framesOut, GAIN_PAN_TEST_BLOCK_SIZE, &framesRead) != MA_SUCCESS || framesRead != GAIN_PAN_TEST_BLOCK_SIZE) {
+            pErrorMessage = "Failed to read from the engine.";
+            goto done;
+        }
+
+        for (iFrame = 0; iFrame < GAIN_PAN_TEST_BLOCK_SIZE; iFrame += 1) {
+            test_gain_pan__calculate_expected_frame(pCase, pFramesIn + (totalFramesRead + iFrame)*2, totalFramesRead + iFrame, expectedFrame);
+
+            for (iChannel = 0; iChannel < 2; iChannel += 1) {
+                float difference = framesOut[iFrame*TEST_ENGINE_CHANNELS + iChannel] - expectedFrame[iChannel];
+                if (difference > GAIN_PAN_TEST_TOLERANCE || difference < -GAIN_PAN_TEST_TOLERANCE) {
+                    printf("    Frame %u, channel %u: expected %f, got %f.\n", totalFramesRead + iFrame, iChannel, expectedFrame[iChannel], framesOut[iFrame*TEST_ENGINE_CHANNELS + iChannel]);
+                    pErrorMessage = "The output did not match applying the gain and pan separately.";
+                    goto done;
+                }
+            }
+        }
+
+        totalFramesRead += GAIN_PAN_TEST_BLOCK_SIZE;
+    }
+
+done:
+    ma_sound_uninit(&sound);
+    ma_audio_buffer_uninit(&audioBuffer);
+    ma_free(pFramesIn, NULL);
+    ma_engine_uninit(&engine);
+
+    return test_engine__report(pErrorMessage);
+}
+
+int test_entry__engine_gain_pan(int argc, char** argv)
+{
+    static const test_gain_pan_case cases[] = {
+        /* panMode                     pan    volume  fade                     smooth  new volume */
+        { ma_pan_mode_balance,        -0.6f,  0.8f,   1.0f, 1.0f,    0,        0,      0.0f,  0 },   /* Constant gains. */
+        { ma_pan_mode_balance,         0.3f,  0.5f,   1.0f, 1.0f,    0,        0,      0.9f,  4 },   /* Volume changed without smoothing. */
+        { ma_pan_mode_balance,         0.3f,  1.0f,   0.0f, 1.0f,    1000,     0,      0.0f,  0 },   /* Fade in. */
+        { ma_pan_mode_constant_power,  0.5f,  0.7f,   1.0f, 0.2f,    2500,     0,      0.0f,  0 },   /* Fade out that ends part way through a block. */
+        { ma_pan_mode_constant_power,  0.0f,  1.0f,   1.0f, 0.0f,    1500,     0,      0.0f,  0 },   /* Fade with no pan. */
+        { ma_pan_mode_balance,         0.4f,  1.0f,   1.0f, 1.0f,    0,        1000,   0.25f, 3 },   /* Volume ramp. */
+        { ma_pan_mode_constant_power, -0.8f,  0.9f,   0.2f, 1.0f,    3000,     700,    0.3f,  2 }    /* Volume ramp ending part way through a fade. */
+    };
+    ma_bool32 hasError = MA_FALSE;
+    size_t iCase;
+
+    (void)argc;
+    (void)argv;
+
+    for (iCase = 0; iCase < ma_countof(cases); iCase += 1) {
+        if (test_gain_pan__run(&cases[iCase]) != MA_SUCCESS) {
+            hasError = MA_TRUE;
+        }
+    }
+
+    if (hasError) {
+        return -1;
+    }
+
+    return 0;
+}
@@ -0,0 +1,204 @@
+/*
+A full scale sine wave has a peak of 1 and an RMS of 1/sqrt(2). Blocks always hold a whole number of half cycles so the RMS of each
+block is exactly that of the whole wave. The wave is started at its peak so that every block starts and ends near full scale, which
+makes the samples left over at the end of a block count for something. The meter only covers the most recent block so blocks are kept smaller than what the engine
+reads from its nodes in one go.
+*/
+#define METERING_TEST_SOUND_LENGTH      48000
+#define METERING_TEST_MAX_BLOCK_SIZE    480
+#define METERING_TEST_TOLERANCE         0.001f
+
+typedef struct
+{
+    ma_uint32 periodInFrames;
+    ma_uint32 blockSize;            /* Must be a multiple of half the period. */
+    float volume;
+} test_metering_case;
+
+static ma_result test_metering__init_sine_buffer(ma_uint32 periodInFrames, ma_audio_buffer* pAudioBuffer)
+{
+    ma_result result;
+    ma_audio_buffer_config audioBufferConfig;
+    float* pFrames;
+    ma_uint64 iFrame;
+
+    pFrames = (float*)ma_malloc((size_t)(METERING_TEST_SOUND_LENGTH * sizeof(float)), NULL);
+    if (pFrames == NULL) {
+        return MA_OUT_OF_MEMORY;
+    }
+
+    for (iFrame = 0; iFrame < METERING_TEST_SOUND_LENGTH; iFrame += 1) {
+        pFrames[iFrame] = (float)ma_cosd(MA_TAU_D * (double)(iFrame % periodInFrames) / periodInFrames);
+    }
+
+    audioBufferConfig = ma_audio_buffer_config_init(ma_format_f32, 1, METERING_TEST_SOUND_LENGTH, pFrames, NULL);
+    result = ma_audio_buffer_init_copy(&audioBufferConfig, pAudioBuffer);
+
+    ma_free(pFrames, NULL);
+
+    return result;
+}
+
+static ma_bool32 test_metering__is_close(float actual, float expected)
+{
+    return actual > expected - METERING_TEST_TOLERANCE && actual < expected + METERING_TEST_TOLERANCE;
+}
+
+static ma_result test_metering__read_block(ma_engine* pEngine, ma_uint32 blockSize)
+{
+    float frames[METERING_TEST_MAX_BLOCK_SIZE * TEST_ENGINE_CHANNELS];
+    ma_uint64 framesRead;
+
+    MA_ASSERT(blockSize <= METERING_TEST_MAX_BLOCK_SIZE);
+    return ma_engine_read_pcm_frames(pEngine, frames, blockSize, &framesRead);
+}
+
+static ma_result test_metering__run(const test_metering_case* pCase)
+{
+    ma_engine engine;
+    ma_audio_buffer audioBuffer;
+    ma_sound_group group;
+    ma_sound_config soundConfig;
+    ma_sound sound;
+    float peak;
+    float rms;
+    float expectedPeak;
+    float expectedRMS;
+    ma_uint32 iBlock;
+    const char* pErrorMessage = NULL;
+
+    printf("    %u frame period, %u frame blocks, volume %.2f\n", pCase->periodInFrames, pCase->blockSize, pCase->volume);
+
+    if (test_engine__init(NULL, &engine) != MA_SUCCESS) {
+        printf("    Failed to initialize the engine.\n");
+        return MA_ERROR;
+    }
+
+    if (test_metering__init_sine_buffer(pCase->periodInFrames, &audioBuffer) != MA_SUCCESS) {
+        printf("    Failed to initialize the audio buffer.\n");
+        ma_engine_uninit(&engine);
+        return MA_ERROR;
+    }
+
+    if (ma_sound_group_init(&engine, MA_SOUND_FLAG_NO_SPATIALIZATION | MA_SOUND_FLAG_METERING, NULL, &group) != MA_SUCCESS) {
+        printf("    Failed to initialize the group.\n");
+        ma_audio_buffer_uninit(&audioBuffer);
+        ma_engine_uninit(&engine);
+        return MA_ERROR;
+    }
+
+    soundConfig = ma_sound_config_init_2(&engine);
+    soundConfig.pDataSource        = &audioBuffer;
+    soundConfig.pInitialAttachment = &group;
+    soundConfig.flags              = MA_SOUND_FLAG_NO_SPATIALIZATION | MA_SOUND_FLAG_NO_PITCH | MA_SOUND_FLAG_METERING;
+    soundConfig.isLooping          = MA_TRUE;
+
+    if (ma_sound_init_ex(&engine, &soundConfig, &sound) != MA_SUCCESS) {
+        printf("    Failed to initialize the sound.\n");
+        ma_sound_group_uninit(&group);
+        ma_audio_buffer_uninit(&audioBuffer);
+        ma_engine_uninit(&engine);
+        return MA_ERROR;
+    }
+
+    ma_sound_set_volume(&sound, pCase->volume);
+    ma_sound_start(&sound);
+
+    expectedPeak = pCase->volume;
+    expectedRMS  = pCase->volume * (float)(1 / ma_sqrtd(2));
+
+    /* A few blocks are read first so any smoothing of the volume has settled. Every block after that must measure the same. */
+    for (iBlock = 0; iBlock < 20; iBlock += 1) {
+        if (test_metering__read_block(&engine, pCase->blockSize) != MA_SUCCESS) {
+            pErrorMessage = "Failed to read from the engine.";
+            goto done;
+        }
+
+        if (iBlock < 10) {
+            continue;
+        }
+
+        ma_sound_get_meter(&sound, &peak, &rms);
+        if (!test_metering__is_close(peak, expectedPeak) || !test_metering__is_close(rms, expectedRMS)) {
+            printf("    Sound: expected peak %f and RMS %f, got %f and %f.\n", expectedPeak, expectedRMS, peak, rms);
+            pErrorMessage = "The sound's meter did not match the level of the sine wave.";
+            goto done;
+        }
+
+        /* The sound is the only thing in the group, and its mono data is copied to every channel, so the group is at the same level. */
+        ma_sound_group_get_meter(&group, &peak, &rms);
+        if (!test_metering__is_close(peak, expectedPeak) || !test_metering__is_close(rms, expectedRMS)) {
+            printf("    Group: expected peak %f and RMS %f, got %f and %f.\n", expectedPeak, expectedRMS, peak, rms);
+            pErrorMessage = "The group's meter did not match the level of the sine wave.";
+            goto done;
+        }
+    }
+
+    /* A stopped sound is silent. */
+    ma_sound_stop(&sound);
+    if (test_metering__read_block(&engine, pCase->blockSize) != MA_SUCCESS) {
+        pErrorMessage = "Failed to read from the engine.";
+        goto done;
+    }
+
+    ma_sound_get_meter(&sound, &peak, &rms);
+    if (peak != 0 || rms != 0) {
+        pErrorMessage = "A stopped sound still had a level.";
+        goto done;
+    }
+
+    /* Disabling metering clears the levels rather than leaving the last block's behind. */
+    ma_sound_start(&sound);
+    if (test_metering__read_block(&engine, pCase->blockSize) != MA_SUCCESS) {
+        pErrorMessage = "Failed to read from the engine.";
+        goto done;
+    }
+
+    ma_sound_set_metering_enabled(&sound, MA_FALSE);
+    ma_sound_get_meter(&sound, &peak, &rms);
+    if (peak != 0 || rms != 0) {
+        pErrorMessage = "The levels were left behind when metering was disabled.";
+        goto done;
+    }
+
+done:
+    ma_sound_uninit(&sound);
+    ma_sound_group_uninit(&group);
+    ma_audio_buffer_uninit(&audioBuffer);
+    ma_engine_uninit(&engine);
+
+    return test_engine__report(pErrorMessage);
+}
+
+int test_entry__engine_metering(int argc, char** argv)
+{
+    /*
+    Blocks of an odd number of frames leave samples over after the groups of four that the SIMD paths work on, so the tail of the
+    block is measured separately.
+    */
+    static const test_metering_case cases[] = {
+        {  48, 480, 1.0f  },
+        {  48,  24, 1.0f  },
+        { 150,  75, 1.0f  },
+        { 150, 225, 1.0f  },
+        {  48, 480, 0.5f  },
+        { 150,  75, 0.25f }
+    };
+    ma_bool32 hasError = MA_FALSE;
+    size_t iCase;
+
+    (void)argc;
+    (void)argv;
+
+    for (iCase = 0; iCase < ma_countof(cases); iCase += 1) {
+        if (test_metering__run(&cases[iCase]) != MA_SUCCESS) {
+            hasError = MA_TRUE;
+        }
+    }
+
+    if (hasError) {
+        return -1;
+    }
+
+    return 0;
+}
@@ -0,0 +1,307 @@
+/* Instances are played from raw memory so the only allocations are the pool's own. */
+#define SOUND_POOL_TEST_SOUND_LENGTH        100
+#define SOUND_POOL_TEST_BLOCK_SIZE          256
+#define SOUND_POOL_TEST_THREAD_COUNT        4
+#define SOUND_POOL_TEST_PLAYS_PER_THREAD    64
+
+static void* test_sound_pool__malloc(size_t sz, void* pUserData)
+{
+    ma_atomic_fetch_add_32((ma_uint32*)pUserData, 1);
+    return ma_malloc(sz, NULL);
+}
+
+static void* test_sound_pool__realloc(void* p, size_t sz, void* pUserData)
+{
+    ma_atomic_fetch_add_32((ma_uint32*)pUserData, 1);
+    return ma_realloc(p, sz, NULL);
+}
+
+static void test_sound_pool__free(void* p, void* pUserData)
+{
+    (void)pUserData;
+    ma_free(p, NULL);
+}
+
+static ma_uint64 test_sound_pool__read_block(ma_engine* pEngine)
+{
+    float frames[SOUND_POOL_TEST_BLOCK_SIZE * TEST_ENGINE_CHANNELS];
+    ma_uint64 framesRead;
+
+    if (ma_engine_read_pcm_frames(pEngine, frames, SOUND_POOL_TEST_BLOCK_SIZE, &framesRead) != MA_SUCCESS) {
+        return 0;
+    }
+
+    return test_engine__count_audible_frames(frames, framesRead);
+}
+
+typedef struct
+{
+    ma_sound_pool* pPool;
+    const ma_sound_instance_config* pInstanceConfig;
+    ma_uint64 instanceIDs[SOUND_POOL_TEST_PLAYS_PER_THREAD];
+    ma_uint32 playCount;
+} test_sound_pool_player;
+
+static ma_thread_result MA_THREADCALL test_sound_pool__player_thread(void* pUserData)
+{
+    test_sound_pool_player* pPlayer = (test_sound_pool_player*)pUserData;
+
+    for (pPlayer->playCount = 0; pPlayer->playCount < SOUND_POOL_TEST_PLAYS_PER_THREAD; pPlayer->playCount += 1) {
+        if (ma_sound_pool_play(pPlayer->pPool, pPlayer->pInstanceConfig, &pPlayer->instanceIDs[pPlayer->playCount]) != MA_SUCCESS) {
+            break;
+        }
+    }
+
+    return (ma_thread_result)0;
+}
+
+/* Every instance played at the same time from several threads must end up in its own slot. */
+static ma_result test_sound_pool__play_from_threads(ma_engine* pEngine, const ma_sound_instance_config* pInstanceConfig)
+{
+    ma_result result;
+    ma_sound_pool_config poolConfig;
+    ma_sound_pool pool;
+    test_sound_pool_player players[SOUND_POOL_TEST_THREAD_COUNT];
+    ma_thread threads[SOUND_POOL_TEST_THREAD_COUNT];
+    ma_bool8 isSlotUsed[SOUND_POOL_TEST_THREAD_COUNT * SOUND_POOL_TEST_PLAYS_PER_THREAD];
+    ma_uint32 iPlayer;
+    ma_uint32 iPlay;
+    const char* pErrorMessage = NULL;
+
+    poolConfig = ma_sound_pool_config_init(SOUND_POOL_TEST_THREAD_COUNT * SOUND_POOL_TEST_PLAYS_PER_THREAD);
+    result = ma_sound_pool_init(pEngine, &poolConfig, &pool);
+    if (result != MA_SUCCESS) {
+        return result;
+    }
+
+    for (iPlayer = 0; iPlayer < SOUND_POOL_TEST_THREAD_COUNT; iPlayer += 1) {
+        players[iPlayer].pPool           = &pool;
+        players[iPlayer].pInstanceConfig = pInstanceConfig;
+        players[iPlayer].playCount       = 0;
+        ma_thread_create(&threads[iPlayer], ma_thread_priority_default, 0, test_sound_pool__player_thread, &players[iPlayer], NULL);
+    }
+
+    for (iPlayer = 0; iPlayer < SOUND_POOL_TEST_THREAD_COUNT; iPlayer += 1) {
+        ma_thread_wait(&threads[iPlayer]);
+    }
+
+    MA_ZERO_MEMORY(isSlotUsed, sizeof(isSlotUsed));
+
+    for (iPlayer = 0; iPlayer < SOUND_POOL_TEST_THREAD_COUNT; iPlayer += 1) {
+        if (players[iPlayer].playCount != SOUND_POOL_TEST_PLAYS_PER_THREAD) {
+            pErrorMessage = "Playing from several threads at once ran out of instances.";
+            goto done;
+        }
+
+        for (iPlay = 0; iPlay < SOUND_POOL_TEST_PLAYS_PER_THREAD; iPlay += 1) {
+            ma_uint32 index = (ma_uint32)(players[iPlayer].instanceIDs[iPlay] & 0xFFFFFFFF);
+
+            if (isSlotUsed[index]) {
+                pErrorMessage = "Two threads were given the same instance.";
+                goto done;
+            }
+
+            isSlotUsed[index] = MA_TRUE;
+        }
+    }
+
+    if (ma_sound_pool_get_playing_count(&pool) != SOUND_POOL_TEST_THREAD_COUNT * SOUND_POOL_TEST_PLAYS_PER_THREAD) {
+        pErrorMessage = "Not every instance is playing.";
+        goto done;
+    }
+
+done:
+    ma_sound_pool_uninit(&pool);
+    return test_engine__report(pErrorMessage);
+}
+
+int test_entry__engine_sound_pool(int argc, char** argv)
+{
+    ma_result result;
+    ma_uint32 allocationCount = 0;
+    ma_uint32 allocationCountBeforePlaying;
+    ma_allocation_callbacks allocationCallbacks;
+    ma_engine engine;
+    ma_sound_pool_config poolConfig;
+    ma_sound_pool pool;
+    ma_sound_instance_config instanceConfig;
+    ma_uint64 instanceIDs[3];
+    ma_uint64 staleInstanceID;
+    float frames[SOUND_POOL_TEST_SOUND_LENGTH];
+    float stereoFrames[SOUND_POOL_TEST_SOUND_LENGTH * 2];
+    ma_uint32 iFrame;
+    ma_bool32 isPoolInitialized = MA_FALSE;
+    const char* pErrorMessage = NULL;
+
+    (void)argc;
+    (void)argv;
+
+    for (iFrame = 0; iFrame < SOUND_POOL_TEST_SOUND_LENGTH; iFrame += 1) {
+        frames[iFrame]           = 0.5f;
+        stereoFrames[iFrame*2+0] = 0.5f;
+        stereoFrames[iFrame*2+1] = 0.5f;
+    }
+
+    allocationCallbacks.pUserData = &allocationCount;
+    allocationCallbacks.onMalloc  = test_sound_pool__malloc;
+    allocationCallbacks.onRealloc = test_sound_pool__realloc;
+    allocationCallbacks.onFree    = test_sound_pool__free;
+
+    if (test_engine__init(&allocationCallbacks, &engine) != MA_SUCCESS) {
+        printf("    Failed to initialize the engine.\n");
+        return -1;
+    }
+
+    poolConfig = ma_sound_pool_config_init(2);
+    if (ma_sound_pool_init(&engine, &poolConfig, &pool) != MA_SUCCESS) {
+        pErrorMessage = "Failed to initialize the pool.";
+        goto done;
+    }
+
+    isPoolInitialized = MA_TRUE;
+
+    instanceConfig = ma_sound_instance_config_init();
+    instanceConfig.pFrames    = frames;
+    instanceConfig.frameCount = SOUND_POOL_TEST_SOUND_LENGTH;
+    instanceConfig.format     = ma_format_f32;
+    instanceConfig.channels   = 1;
+    instanceConfig.flags      = MA_SOUND_FLAG_NO_PITCH | MA_SOUND_FLAG_NO_SPATIALIZATION;
+
+    /* Play to the end. The instance is finished once it has been read to the end. */
+    if (ma_sound_pool_play(&pool, &instanceConfig, &instanceIDs[0]) != MA_SUCCESS || !ma_sound_pool_is_playing(&pool, instanceIDs[0])) {
+        pErrorMessage = "Failed to play an instance.";
+        goto done;
+    }
+
+    if (test_sound_pool__read_block(&engine) != SOUND_POOL_TEST_SOUND_LENGTH || ma_sound_pool_is_playing(&pool, instanceIDs[0]) || ma_sound_pool_get_playing_count(&pool) != 0) {
+        pErrorMessage = "An instance did not play to the end and finish.";
+        goto done;
+    }
+
+    /* Fill the pool. The finished instance is reused, which makes its old ID stale. */
+    staleInstanceID = instanceIDs[0];
+    instanceConfig.isLooping = MA_TRUE;
+
+    if (ma_sound_pool_play(&pool, &instanceConfig, &instanceIDs[0]) != MA_SUCCESS || ma_sound_pool_play(&pool, &instanceConfig, &instanceIDs[1]) != MA_SUCCESS) {
+        pErrorMessage = "Failed to reuse a finished instance.";
+        goto done;
+    }
+
+    if ((instanceIDs[0] & 0xFFFFFFFF) != (staleInstanceID & 0xFFFFFFFF) && (instanceIDs[1] & 0xFFFFFFFF) != (staleInstanceID & 0xFFFFFFFF)) {
+        pErrorMessage = "The finished instance was not reused.";
+        goto done;
+    }
+
+    if (instanceIDs[0] == staleInstanceID || instanceIDs[1] == staleInstanceID || ma_sound_pool_is_playing(&pool, staleInstanceID) || ma_sound_pool_stop(&pool, staleInstanceID) == MA_SUCCESS) {
+        pErrorMessage = "A stale instance ID still refers to the reused instance.";
+        goto done;
+    }
+
+    if (ma_sound_pool_play(&pool, &instanceConfig, &instanceIDs[2]) != MA_OUT_OF_MEMORY || instanceIDs[2] != 0) {
+        pErrorMessage = "Playing on a full pool did not fail with MA_OUT_OF_MEMORY.";
+        goto done;
+    }
+
+    /* A stopped instance can only be reused once the audio thread has let go of it. */
+    ma_sound_pool_stop(&pool, instanceIDs[0]);
+
+    if (ma_sound_pool_play(&pool, &instanceConfig, &instanceIDs[2]) != MA_OUT_OF_MEMORY) {
+        pErrorMessage = "A stopped instance was reused before the audio thread let go of it.";
+        goto done;
+    }
+
+    if (test_sound_pool__read_block(&engine) != SOUND_POOL_TEST_BLOCK_SIZE || ma_sound_pool_play(&pool, &instanceConfig, &instanceIDs[2]) != MA_SUCCESS) {
+        pErrorMessage = "A stopped instance was not reused.";
+        goto done;
+    }
+
+    ma_sound_pool_uninit(&pool);
+    isPoolInitialized = MA_FALSE;
+
+    /* Every stage is preallocated so playing with pitching and spatialization, and at another sample rate, must not allocate. */
+    poolConfig = ma_sound_pool_config_init(4);
+    if (ma_sound_pool_init(&engine, &poolConfig, &pool) != MA_SUCCESS) {
+        pErrorMessage = "Failed to initialize the pool.";
+        goto done;
+    }
+
+    isPoolInitialized = MA_TRUE;
+
+    allocationCountBeforePlaying = ma_atomic_load_32(&allocationCount);
+
+    instanceConfig.flags      = 0;
+    instanceConfig.isLooping  = MA_FALSE;
+    instanceConfig.pitch      = 1.5f;
+    result = ma_sound_pool_play(&pool, &instanceConfig, NULL);
+
+    instanceConfig.pFrames    = stereoFrames;
+    instanceConfig.channels   = 2;
+    instanceConfig.sampleRate = 44100;
+    if (result == MA_SUCCESS) {
+        result = ma_sound_pool_play(&pool, &instanceConfig, NULL);
+    }
+
+    if (result != MA_SUCCESS || test_sound_pool__read_block(&engine) == 0 || ma_sound_pool_get_playing_count(&pool) != 0 || ma_sound_pool_play(&pool, &instanceConfig, NULL) != MA_SUCCESS) {
+        pErrorMessage = "Failed to play instances with every stage.";
+        goto done;
+    }
+
+    if (ma_atomic_load_32(&allocationCount) != allocationCountBeforePlaying) {
+        pErrorMessage = "Playing an instance allocated memory.";
+        goto done;
+    }
+
+    ma_sound_pool_uninit(&pool);
+    isPoolInitialized = MA_FALSE;
+
+    /* Instances with more channels than the stages were allocated for are rejected, as are resampled instances when there's no resampler. */
+    poolConfig = ma_sound_pool_config_init(4);
+    poolConfig.maxChannels = 1;
+    poolConfig.flags       = MA_SOUND_FLAG_NO_PITCH;
+    if (ma_sound_pool_init(&engine, &poolConfig, &pool) != MA_SUCCESS) {
+        pErrorMessage = "Failed to initialize the pool.";
+        goto done;
+    }
+
+    isPoolInitialized = MA_TRUE;
+
+    if (ma_sound_pool_play(&pool, &instanceConfig, NULL) != MA_INVALID_ARGS) {
+        pErrorMessage = "An instance with more channels than the pool's maximum was played.";
+        goto done;
+    }
+
+    instanceConfig.pFrames  = frames;
+    instanceConfig.channels = 1;
+    if (ma_sound_pool_play(&pool, &instanceConfig, NULL) != MA_INVALID_ARGS) {
+        pErrorMessage = "An instance that needs resampling was played on a pool without resamplers.";
+        goto done;
+    }
+
+    instanceConfig.sampleRate = 0;
+    if (ma_sound_pool_play(&pool, &instanceConfig, NULL) != MA_SUCCESS || ma_sound_pool_get_playing_count(&pool) != 1) {
+        pErrorMessage = "Failed to play on a pool without resamplers.";
+        goto done;
+    }
+
+    ma_sound_pool_uninit(&pool);
+    isPoolInitialized = MA_FALSE;
+
+    instanceConfig.isLooping = MA_TRUE;
+    if (test_sound_pool__play_from_threads(&engine, &instanceConfig) != MA_SUCCESS) {
+        ma_engine_uninit(&engine);
+        return -1;
+    }
+
+done:
+    if (isPoolInitialized) {
+        ma_sound_pool_uninit(&pool);
+    }
+
+    ma_engine_uninit(&engine);
+
+    if (test_engine__report(pErrorMessage) != MA_SUCCESS) {
+        return -1;
+    }
+
+    return 0;
+}
@@ -0,0 +1,46 @@
+#include "../test_common/ma_test_common.c"
+
+#include "ma_test_job_queue_stress.c"
+#include "ma_test_job_queue_throughput.c"
+#include "ma_test_job_queue_priority.c"
+
+int main(int argc, char** argv)
+{
+    ma_result result;
+    ma_bool32 hasError = MA_FALSE;
+    size_t iTest;
+
+    (void)argc;
+    (void)argv;
+
+    result = ma_register_test("Stress", test_entry__job_queue_stress);
+    if (result != MA_SUCCESS) {
+        return result;
+    }
+
+    result = ma_register_test("Throughput", test_entry__job_queue_throughput);
+    if (result != MA_SUCCESS) {
+        return result;
+    }
+
+    result = ma_register_test("Priority", test_entry__job_queue_priority);
+    if (result != MA_SUCCESS) {
+        return result;
+    }
+
+    for (iTest = 0; iTest < g_Tests.count; iTest += 1) {
+        printf("=== BEGIN %s ===\n", g_Tests.pTests[iTest].pName);
+        result = g_Tests.pTests[iTest].onEntry(argc, argv);
+        printf("=== END %s : %s ===\n", g_Tests.pTests[iTest].pName, (result == 0) ? "PASSED" : "FAILED");
+
+        if (result != 0) {
+            hasError = MA_TRUE;
+        }
+    }
+
+    if (hasError) {
+        return -1;  /* Something failed. */
+    } else {
+        return 0;   /* Everything passed. */
+    }
+}
@@ -0,0 +1,277 @@
+/*
+Checks the order jobs come out of a single job queue. The most urgent job comes out first and jobs of the same priority come out in
+the order they were posted, but a steady stream of high priority jobs must not hold up a waiting normal priority job for longer than
+MA_JOB_QUEUE_MAX_HIGH_PRIORITY_RUN jobs. Low priority jobs come out once there's nothing else left.
+*/
+#define PRIORITY_TEST_QUEUE_CAPACITY    256
+#define PRIORITY_TEST_FLOOD_LENGTH      (MA_JOB_QUEUE_MAX_HIGH_PRIORITY_RUN * 10)
+
+/* Jobs are tagged with their priority in the top byte of data0 and the order they were posted within that priority in the rest. */
+#define PRIORITY_TEST_TAG(priority, index)  (((ma_uint32)(priority) << 24) | (ma_uint32)(index))
+#define PRIORITY_TEST_PRIORITY(tag)         ((ma_job_priority)((tag) >> 24))
+#define PRIORITY_TEST_INDEX(tag)            ((tag) & 0x00FFFFFF)
+
+static ma_result test_job_queue_priority__post(ma_job_queue* pQueue, ma_job_priority priority, ma_uint32 index)
+{
+    ma_job job;
+
+    job = ma_job_init(MA_JOB_TYPE_CUSTOM);
+    job.priority          = priority;
+    job.data.custom.data0 = PRIORITY_TEST_TAG(priority, index);
+
+    return ma_job_queue_post(pQueue, &job);
+}
+
+static ma_result test_job_queue_priority__next(ma_job_queue* pQueue, ma_uint32* pTag)
+{
+    ma_result result;
+    ma_job job;
+
+    result = ma_job_queue_next(pQueue, &job);
+    if (result != MA_SUCCESS) {
+        return result;
+    }
+
+    if (job.priority != PRIORITY_TEST_PRIORITY((ma_uint32)job.data.custom.data0)) {
+        return MA_INVALID_DATA;
+    }
+
+    *pTag = (ma_uint32)job.data.custom.data0;
+    return MA_SUCCESS;
+}
+
+static ma_result test_job_queue_priority__init(ma_job_queue* pQueue)
+{
+    ma_job_queue_config config;
+
+    config = ma_job_queue_config_init(MA_JOB_QUEUE_FLAG_NON_BLOCKING, PRIORITY_TEST_QUEUE_CAPACITY);
+    return ma_job_queue_init(&config, NULL, pQueue);
+}
+
+static ma_result test_job_queue_priority__report(const char* pErrorMessage)
+{
+    if (pErrorMessage != NULL) {
+        printf("    %s\n", pErrorMessage);
+        return MA_ERROR;
+    }
+
+    return MA_SUCCESS;
+}
+
+/* Mixed posts come out high, then normal, then low, in the order they were posted within each priority. */
+static ma_result test_job_queue_priority__order(void)
+{
+    static const ma_job_priority postOrder[] = {
+        ma_job_priority_low, ma_job_priority_normal, ma_job_priority_high,
+        ma_job_priority_low, ma_job_priority_high,   ma_job_priority_normal,
+        ma_job_priority_high, ma_job_priority_low
+    };
+    ma_job_queue queue;
+    ma_uint32 nextIndex[MA_JOB_PRIORITY_COUNT] = {0, 0, 0};
+    ma_uint32 expectedIndex[MA_JOB_PRIORITY_COUNT] = {0, 0, 0};
+    ma_job_priority expectedPriority = ma_job_priority_high;
+    ma_uint32 tag;
+    size_t iPost;
+    const char* pErrorMessage = NULL;
+
+    printf("    Order\n");
+
+    if (test_job_queue_priority__init(&queue) != MA_SUCCESS) {
+        return test_job_queue_priority__report("Failed to initialize the job queue.");
+    }
+
+    for (iPost = 0; iPost < ma_countof(postOrder); iPost += 1) {
+        if (test_job_queue_priority__post(&queue, postOrder[iPost], nextIndex[postOrder[iPost]]) != MA_SUCCESS) {
+            pErrorMessage = "Failed to post a job.";
+            goto done;
+        }
+
+        nextIndex[postOrder[iPost]] += 1;
+    }
+
+    for (iPost = 0; iPost < ma_countof(postOrder); iPost += 1) {
+        if (test_job_queue_priority__next(&queue, &tag) != MA_SUCCESS) {
+            pErrorMessage = "A posted job did not come out of the queue.";
+            goto done;
+        }
+
+        /* Move down a priority once every job of the current one has come out. */
+        while (expectedIndex[expectedPriority] == nextIndex[expectedPriority]) {
+            expectedPriority = (ma_job_priority)(expectedPriority - 1);
+        }
+
+        if (PRIORITY_TEST_PRIORITY(tag) != expectedPriority) {
+            pErrorMessage = "A job came out ahead of a more urgent one.";
+            goto done;
+        }
+
+        if (PRIORITY_TEST_INDEX(tag) != expectedIndex[expectedPriority]) {
+            pErrorMessage = "Jobs of the same priority came out in a different order to how they were posted.";
+            goto done;
+        }
+
+        expectedIndex[expectedPriority] += 1;
+    }
+
+    if (test_job_queue_priority__next(&queue, &tag) != MA_NO_DATA_AVAILABLE) {
+        pErrorMessage = "More jobs came out of the queue than were posted.";
+        goto done;
+    }
+
+done:
+    ma_job_queue_uninit(&queue, NULL);
+    return test_job_queue_priority__report(pErrorMessage);
+}
+
+/*
+A few normal and low priority jobs are left waiting while high priority jobs keep getting posted, always keeping some in the queue. Each
+normal priority job has to come out after no more than MA_JOB_QUEUE_MAX_HIGH_PRIORITY_RUN high priority jobs. The low priority jobs have
+to wait until the flood stops, but must then come out.
+*/
+static ma_result test_job_queue_priority__starvation(void)
+{
+    ma_job_queue queue;
+    ma_uint32 highPostCount = 0;
+    ma_uint32 highCount = 0;
+    ma_uint32 normalCount = 0;
+    ma_uint32 lowCount = 0;
+    ma_uint32 highRun = 0;
+    ma_uint32 tag;
+    ma_uint32 iJob;
+    ma_result result;
+    const char* pErrorMessage = NULL;
+
+    printf("    Starvation\n");
+
+    if (test_job_queue_priority__init(&queue) != MA_SUCCESS) {
+        return test_job_queue_priority__report("Failed to initialize the job queue.");
+    }
+
+    for (iJob = 0; iJob < 4; iJob += 1) {
+        if (test_job_queue_priority__post(&queue, ma_job_priority_normal, iJob) != MA_SUCCESS ||
+            test_job_queue_priority__post(&queue, ma_job_priority_low,    iJob) != MA_SUCCESS) {
+            pErrorMessage = "Failed to post a job.";
+            goto done;
+        }
+    }
+
+    for (iJob = 0; iJob < MA_JOB_QUEUE_MAX_HIGH_PRIORITY_RUN * 2; iJob += 1) {
+        if (test_job_queue_priority__post(&queue, ma_job_priority_high, highPostCount++) != MA_SUCCESS) {
+            pErrorMessage = "Failed to post a job.";
+            goto done;
+        }
+    }
+
+    /* The flood. A high priority job is posted for every job taken so there are always plenty of them waiting. */
+    for (iJob = 0; iJob < PRIORITY_TEST_FLOOD_LENGTH; iJob += 1) {
+        if (test_job_queue_priority__next(&queue, &tag) != MA_SUCCESS) {
+            pErrorMessage = "A posted job did not come out of the queue.";
+            goto done;
+        }
+
+        if (PRIORITY_TEST_PRIORITY(tag) == ma_job_priority_high) {
+            if (PRIORITY_TEST_INDEX(tag) != highCount) {
+                pErrorMessage = "High priority jobs came out in a different order to how they were posted.";
+                goto done;
+            }
+
+            highCount += 1;
+            highRun   += 1;
+
+            if (highRun > MA_JOB_QUEUE_MAX_HIGH_PRIORITY_RUN && normalCount < 4) {
+                pErrorMessage = "A normal priority job was held up by too many high priority jobs.";
+                goto done;
+            }
+        } else if (PRIORITY_TEST_PRIORITY(tag) == ma_job_priority_normal) {
+            if (PRIORITY_TEST_INDEX(tag) != normalCount) {
+                pErrorMessage = "Normal priority jobs came out in a different order to how they were posted.";
+                goto done;
+            }
+
+            /* Jumping the queue earlier than it needs to means the high priority jobs aren't getting their due. */
+            if (highRun != MA_JOB_QUEUE_MAX_HIGH_PRIORITY_RUN) {
+                pErrorMessage = "A normal priority job came out ahead of a high priority job before the limit was reached.";
+                goto done;
+            }
+
+            normalCount += 1;
+            highRun      = 0;
+        } else {
+            pErrorMessage = "A low priority job came out while more urgent jobs were waiting.";
+            goto done;
+        }
+
+        if (test_job_queue_priority__post(&queue, ma_job_priority_high, highPostCount++) != MA_SUCCESS) {
+            pErrorMessage = "Failed to post a job.";
+            goto done;
+        }
+    }
+
+    if (normalCount != 4) {
+        pErrorMessage = "The normal priority jobs were starved by the high priority jobs.";
+        goto done;
+    }
+
+    /* With the flood over, the remaining high priority jobs drain and then the low priority jobs come out in order. */
+    for (;;) {
+        result = test_job_queue_priority__next(&queue, &tag);
+        if (result == MA_NO_DATA_AVAILABLE) {
+            break;
+        }
+
+        if (result != MA_SUCCESS) {
+            pErrorMessage = "Failed to take a job from the queue.";
+            goto done;
+        }
+
+        if (PRIORITY_TEST_PRIORITY(tag) == ma_job_priority_high) {
+            if (lowCount > 0) {
+                pErrorMessage = "A low priority job came out while high priority jobs were waiting.";
+                goto done;
+            }
+
+            highCount += 1;
+        } else if (PRIORITY_TEST_PRIORITY(tag) == ma_job_priority_low) {
+            if (PRIORITY_TEST_INDEX(tag) != lowCount) {
+                pErrorMessage = "Low priority jobs came out in a different order to how they were posted.";
+                goto done;
+            }
+
+            lowCount += 1;
+        } else {
+            pErrorMessage = "A normal priority job came out twice.";
+            goto done;
+        }
+    }
+
+    if (highCount != highPostCount || lowCount != 4) {
+        pErrorMessage = "Not every posted job came out of the queue.";
+        goto done;
+    }
+
+done:
+    ma_job_queue_uninit(&queue, NULL);
+    return test_job_queue_priority__report(pErrorMessage);
+}
+
+int test_entry__job_queue_priority(int argc, char** argv)
+{
+    ma_bool32 hasError = MA_FALSE;
+
+    (void)argc;
+    (void)argv;
+
+    if (test_job_queue_priority__order() != MA_SUCCESS) {
+        hasError = MA_TRUE;
+    }
+
+    if (test_job_queue_priority__starvation() != MA_SUCCESS) {
+        hasError = MA_TRUE;
+    }
+
+    if (hasError) {
+        return -1;
+    }
+
+    return 0;
+}
@@ -0,0 +1,317 @@
+/*
+Hammers a single ma_job_queue from multiple producer and consumer threads at the same time and checks
+that every job comes out exactly once, that jobs from the same producer and of the same priority come
+out in the order they were posted, and that slots are never lost when the queue runs out of capacity.
+*/
+#define STRESS_JOB_COUNT_PER_PRODUCER   10000
+#define STRESS_MAX_THREAD_COUNT         8
+#define STRESS_QUEUE_CAPACITY           100     /* Deliberately small, and not a multiple of 32, so the queue is full most of the time. */
+
+typedef struct
+{
+    ma_job_queue* pQueue;
+    ma_uint32 producerIndex;
+    ma_uint32 producerCount;
+    ma_uint32 consumerCount;
+    ma_uint32* pSeenCounts;
+    volatile ma_uint32* pProcessedCount;
+    ma_uint32 outOfOrderCount;
+} test_job_queue_stress_thread_data;
+
+static ma_thread_result MA_THREADCALL test_job_queue_stress__producer(void* pUserData)
+{
+    test_job_queue_stress_thread_data* pData = (test_job_queue_stress_thread_data*)pUserData;
+    ma_uint32 iJob;
+
+    for (iJob = 0; iJob < STRESS_JOB_COUNT_PER_PRODUCER; iJob += 1) {
+        ma_job job;
+        ma_result result;
+
+        job = ma_job_init(MA_JOB_TYPE_CUSTOM);
+        job.priority   = iJob % MA_JOB_PRIORITY_COUNT;
+        job.data.custom.data0 = pData->producerIndex;
+        job.data.custom.data1 = iJob;
+
+        for (;;) {
+            result = ma_job_queue_post(pData->pQueue, &job);
+            if (result != MA_OUT_OF_MEMORY) {
+                break;
+            }
+
+            ma_yield();
+        }
+
+        if (result != MA_SUCCESS) {
+            printf("    Failed to post job.\n");
+            break;
+        }
+    }
+
+    return (ma_thread_result)0;
+}
+
+static ma_thread_result MA_THREADCALL test_job_queue_stress__consumer(void* pUserData)
+{
+    test_job_queue_stress_thread_data* pData = (test_job_queue_stress_thread_data*)pUserData;
+    ma_uint32 totalJobCount = pData->producerCount * STRESS_JOB_COUNT_PER_PRODUCER;
+    ma_int64 lastSeen[STRESS_MAX_THREAD_COUNT][MA_JOB_PRIORITY_COUNT];
+    ma_uint32 iProducer;
+    ma_uint32 iPriority;
+
+    for (iProducer = 0; iProducer < STRESS_MAX_THREAD_COUNT; iProducer += 1) {
+        for (iPriority = 0; iPriority < MA_JOB_PRIORITY_COUNT; iPriority += 1) {
+            lastSeen[iProducer][iPriority] = -1;
+        }
+    }
+
+    for (;;) {
+        ma_job job;
+        ma_result result;
+        ma_uint32 producerIndex;
+        ma_uint32 jobIndex;
+
+        result = ma_job_queue_next(pData->pQueue, &job);
+        if (result == MA_CANCELLED) {
+            break;  /* Blocking mode. The quit job is posted when the producers have finished. */
+        }
+
+        if (result == MA_NO_DATA_AVAILABLE) {
+            if (ma_atomic_load_32(pData->pProcessedCount) >= totalJobCount) {
+                break;  /* Non-blocking mode. Everything has been processed. */
+            }
+
+            ma_yield();
+            continue;
+        }
+
+        producerIndex = (ma_uint32)job.data.custom.data0;
+        jobIndex      = (ma_uint32)job.data.custom.data1;
+
+        ma_atomic_fetch_add_32(&pData->pSeenCounts[(producerIndex * STRESS_JOB_COUNT_PER_PRODUCER) + jobIndex], 1);
+        ma_atomic_fetch_add_32(pData->pProcessedCount, 1);
+
+        /* Ordering can only be checked when there's a single consumer. */
+        if (pData->consumerCount == 1) {
+            if ((ma_int64)jobIndex <= lastSeen[producerIndex][job.priority]) {
+                pData->outOfOrderCount += 1;
+            }
+
+            lastSeen[producerIndex][job.priority] = jobIndex;
+        }
+    }
+
+    return (ma_thread_result)0;
+}
+
+static ma_result test_job_queue_stress__run(ma_uint32 producerCount, ma_uint32 consumerCount, ma_uint32 flags)
+{
+    ma_result result;
+    ma_job_queue_config queueConfig;
+    ma_job_queue queue;
+    ma_thread producers[STRESS_MAX_THREAD_COUNT];
+    ma_thread consumers[STRESS_MAX_THREAD_COUNT];
+    test_job_queue_stress_thread_data producerData[STRESS_MAX_THREAD_COUNT];
+    test_job_queue_stress_thread_data consumerData[STRESS_MAX_THREAD_COUNT];
+    ma_uint32* pSeenCounts;
+    MA_ATOMIC(4, ma_uint32) processedCount = 0;
+    ma_uint32 totalJobCount = producerCount * STRESS_JOB_COUNT_PER_PRODUCER;
+    ma_uint32 missingCount = 0;
+    ma_uint32 duplicateCount = 0;
+    ma_uint32 outOfOrderCount = 0;
+    ma_uint32 iThread;
+    ma_uint32 iJob;
+    ma_timer timer;
+    double runTimeInSeconds;
+
+    pSeenCounts = (ma_uint32*)ma_calloc(totalJobCount * sizeof(*pSeenCounts), NULL);
+    if (pSeenCounts == NULL) {
+        return MA_OUT_OF_MEMORY;
+    }
+
+    queueConfig = ma_job_queue_config_init(flags, STRESS_QUEUE_CAPACITY);
+
+    result = ma_job_queue_init(&queueConfig, NULL, &queue);
+    if (result != MA_SUCCESS) {
+        ma_free(pSeenCounts, NULL);
+        return result;
+    }
+
+    ma_timer_init(&timer);
+
+    for (iThread = 0; iThread < consumerCount; iThread += 1) {
+        MA_ZERO_OBJECT(&consumerData[iThread]);
+        consumerData[iThread].pQueue          = &queue;
+        consumerData[iThread].producerCount   = producerCount;
+        consumerData[iThread].consumerCount   = consumerCount;
+        consumerData[iThread].pSeenCounts     = pSeenCounts;
+        consumerData[iThread].pProcessedCount = &processedCount;
+        ma_thread_create(&consumers[iThread], ma_thread_priority_default, 0, test_job_queue_stress__consumer, &consumerData[iThread], NULL);
+    }
+
+    for (iThread = 0; iThread < producerCount; iThread += 1) {
+        MA_ZERO_OBJECT(&producerData[iThread]);
+        producerData[iThread].pQueue        = &queue;
+        producerData[iThread].producerIndex = iThread;
+        ma_thread_create(&producers[iThread], ma_thread_priority_default, 0, test_job_queue_stress__producer, &producerData[iThread], NULL);
+    }
+
+    for (iThread = 0; iThread < producerCount; iThread += 1) {
+        ma_thread_wait(&producers[iThread]);
+    }
+
+    /* In blocking mode the consumers need to be told to stop. The quit job is only returned once everything before it has been processed. */
+    if ((flags & MA_JOB_QUEUE_FLAG_NON_BLOCKING) == 0) {
+        ma_job job = ma_job_init(MA_JOB_TYPE_QUIT);
+
+        while (ma_atomic_load_32(&processedCount) < totalJobCount) {
+            ma_yield();
+        }
+
+        ma_job_queue_post(&queue, &job);
+    }
+
+    for (iThread = 0; iThread < consumerCount; iThread += 1) {
+        ma_thread_wait(&consumers[iThread]);
+        outOfOrderCount += consumerData[iThread].outOfOrderCount;
+    }
+
+    runTimeInSeconds = ma_timer_get_time_in_seconds(&timer);
+
+    for (iJob = 0; iJob < totalJobCount; iJob += 1) {
+        if (pSeenCounts[iJob] == 0) {
+            missingCount += 1;
+        } else if (pSeenCounts[iJob] > 1) {
+            duplicateCount += 1;
+        }
+    }
+
+    ma_job_queue_uninit(&queue, NULL);
+    ma_free(pSeenCounts, NULL);
+
+    printf("    %u producers, %u consumers, %s: %10.0f jobs/sec\n", producerCount, consumerCount, ((flags & MA_JOB_QUEUE_FLAG_NON_BLOCKING) != 0) ? "non-blocking" : "blocking    ", totalJobCount / runTimeInSeconds);
+
+    if (missingCount > 0 || duplicateCount > 0 || outOfOrderCount > 0) {
+        printf("    %u jobs lost, %u jobs duplicated, %u jobs out of order.\n", missingCount, duplicateCount, outOfOrderCount);
+        return MA_ERROR;
+    }
+
+    return MA_SUCCESS;
+}
+
+static ma_result test_job_queue_stress__capacity(void)
+{
+    ma_result result;
+    ma_job_queue_config queueConfig;
+    ma_job_queue queue;
+    ma_job jobs[STRESS_QUEUE_CAPACITY];
+    ma_job job;
+    ma_uint32 postedCount;
+    ma_uint32 expectedCount = 0;
+    ma_uint32 iRound;
+    ma_uint32 iJob;
+
+    queueConfig = ma_job_queue_config_init(MA_JOB_QUEUE_FLAG_NON_BLOCKING, STRESS_QUEUE_CAPACITY);
+
+    result = ma_job_queue_init(&queueConfig, NULL, &queue);
+    if (result != MA_SUCCESS) {
+        return result;
+    }
+
+    for (iJob = 0; iJob < STRESS_QUEUE_CAPACITY; iJob += 1) {
+        jobs[iJob] = ma_job_init(MA_JOB_TYPE_CUSTOM);
+        jobs[iJob].priority = iJob % MA_JOB_PRIORITY_COUNT;
+    }
+
+    /* Filling and draining the queue must always give us the same number of slots. If a slot is leaked it'll show up here. */
+    for (iRound = 0; iRound < 4; iRound += 1) {
+        postedCount = 0;
+        for (;;) {
+            result = ma_job_queue_post(&queue, &jobs[postedCount % STRESS_QUEUE_CAPACITY]);
+            if (result != MA_SUCCESS) {
+                break;
+            }
+
+            postedCount += 1;
+        }
+
+        if (result != MA_OUT_OF_MEMORY) {
+            printf("    Expecting MA_OUT_OF_MEMORY when the queue is full, but got %s.\n", ma_result_description(result));
+            ma_job_queue_uninit(&queue, NULL);
+            return MA_ERROR;
+        }
+
+        if (iRound == 0) {
+            expectedCount = postedCount;
+            if (expectedCount < STRESS_QUEUE_CAPACITY - 1) {
+                printf("    Queue with a capacity of %u only accepted %u jobs.\n", STRESS_QUEUE_CAPACITY, expectedCount);
+                ma_job_queue_uninit(&queue, NULL);
+                return MA_ERROR;
+            }
+        } else if (postedCount != expectedCount) {
+            printf("    Round %u accepted %u jobs, but round 0 accepted %u.\n", iRound, postedCount, expectedCount);
+            ma_job_queue_uninit(&queue, NULL);
+            return MA_ERROR;
+        }
+
+        /* A batch that doesn't fit must not post anything. Drain one job to make room for only part of it. */
+        ma_job_queue_next(&queue, &job);
+        postedCount -= 1;
+
+        result = ma_job_queue_post_batch(&queue, jobs, 2);
+        if (result != MA_OUT_OF_MEMORY) {
+            printf("    Expecting MA_OUT_OF_MEMORY for a batch that doesn't fit, but got %s.\n", ma_result_description(result));
+            ma_job_queue_uninit(&queue, NULL);
+            return MA_ERROR;
+        }
+
+        while (ma_job_queue_next(&queue, &job) == MA_SUCCESS) {
+            postedCount -= 1;
+        }
+
+        if (postedCount != 0) {
+            printf("    Queue returned the wrong number of jobs after a failed batch post.\n");
+            ma_job_queue_uninit(&queue, NULL);
+            return MA_ERROR;
+        }
+    }
+
+    ma_job_queue_uninit(&queue, NULL);
+
+    return MA_SUCCESS;
+}
+
+int test_entry__job_queue_stress(int argc, char** argv)
+{
+    ma_result result;
+    ma_bool32 hasError = MA_FALSE;
+    ma_uint32 threadCount;
+
+    (void)argc;
+    (void)argv;
+
+    result = test_job_queue_stress__capacity();
+    if (result != MA_SUCCESS) {
+        hasError = MA_TRUE;
+    }
+
+    /* A single consumer is used to check ordering. */
+    if (test_job_queue_stress__run(4, 1, 0) != MA_SUCCESS) {
+        hasError = MA_TRUE;
+    }
+
+    for (threadCount = 1; threadCount <= STRESS_MAX_THREAD_COUNT; threadCount *= 2) {
+        if (test_job_queue_stress__run(threadCount, threadCount, 0) != MA_SUCCESS) {
+            hasError = MA_TRUE;
+        }
+
+        if (test_job_queue_stress__run(threadCount, threadCount, MA_JOB_QUEUE_FLAG_NON_BLOCKING) != MA_SUCCESS) {
+            hasError = MA_TRUE;
+        }
+    }
+
+    if (hasError) {
+        return -1;
+    }
+
+    return 0;
+}
@@ -0,0 +1,138 @@
+/*
+Measures how many jobs per second the resource manager's job threads can get through as the number
+of job threads increases. Each job does a small, fixed amount of work to stand in for decoding a
+page of audio data. Jobs are posted in batches from a single thread.
+*/
+#define THROUGHPUT_JOB_COUNT        100000
+#define THROUGHPUT_JOB_BATCH_SIZE   32
+#define THROUGHPUT_JOB_WORK         2000
+
+static MA_ATOMIC(4, ma_uint32) g_throughputJobsProcessed;
+static MA_ATOMIC(4, ma_uint32) g_throughputChecksum;
+
+static ma_result test_job_queue_throughput__job(ma_job* pJob)
+{
+    ma_uint32 x = (ma_uint32)pJob->data.custom.data0;
+    ma_uint32 i;
+
+    for (i = 0; i < THROUGHPUT_JOB_WORK; i += 1) {
+        x = (x * 1664525) + 1013904223;
+    }
+
+    ma_atomic_fetch_add_32(&g_throughputChecksum, x);
+    ma_atomic_fetch_add_32(&g_throughputJobsProcessed, 1);
+
+    return MA_SUCCESS;
+}
+
+static ma_uint32 test_job_queue_throughput__expected_checksum(void)
+{
+    ma_uint32 checksum = 0;
+    ma_uint32 iJob;
+    ma_uint32 i;
+
+    for (iJob = 0; iJob < THROUGHPUT_JOB_COUNT; iJob += 1) {
+        ma_uint32 x = iJob;
+        for (i = 0; i < THROUGHPUT_JOB_WORK; i += 1) {
+            x = (x * 1664525) + 1013904223;
+        }
+
+        checksum += x;
+    }
+
+    return checksum;
+}
+
+static ma_result test_job_queue_throughput__run(ma_uint32 jobThreadCount, ma_uint32 expectedChecksum)
+{
+    ma_result result;
+    ma_resource_manager_config resourceManagerConfig;
+    ma_resource_manager resourceManager;
+    ma_job jobs[THROUGHPUT_JOB_BATCH_SIZE];
+    ma_uint32 iJob;
+    ma_uint32 iBatchJob;
+    ma_timer timer;
+    double runTimeInSeconds;
+
+    resourceManagerConfig = ma_resource_manager_config_init();
+    resourceManagerConfig.jobThreadCount   = jobThreadCount;
+    resourceManagerConfig.jobQueueCapacity = 4096;
+
+    result = ma_resource_manager_init(&resourceManagerConfig, &resourceManager);
+    if (result != MA_SUCCESS) {
+        printf("    Failed to initialize resource manager with %u job threads.\n", jobThreadCount);
+        return result;
+    }
+
+    g_throughputJobsProcessed = 0;
+    g_throughputChecksum      = 0;
+
+    ma_timer_init(&timer);
+
+    for (iJob = 0; iJob < THROUGHPUT_JOB_COUNT; iJob += THROUGHPUT_JOB_BATCH_SIZE) {
+        for (iBatchJob = 0; iBatchJob < THROUGHPUT_JOB_BATCH_SIZE; iBatchJob += 1) {
+            jobs[iBatchJob] = ma_job_init(MA_JOB_TYPE_CUSTOM);
+            jobs[iBatchJob].data.custom.proc  = test_job_queue_throughput__job;
+            jobs[iBatchJob].data.custom.data0 = iJob + iBatchJob;
+        }
+
+        /* The queue has a fixed capacity. If it's full, give the job threads a chance to catch up. */
+        for (;;) {
+            result = ma_resource_manager_post_jobs(&resourceManager, jobs, THROUGHPUT_JOB_BATCH_SIZE);
+            if (result != MA_OUT_OF_MEMORY) {
+                break;
+            }
+
+            ma_yield();
+        }
+
+        if (result != MA_SUCCESS) {
+            printf("    Failed to post jobs.\n");
+            ma_resource_manager_uninit(&resourceManager);
+            return result;
+        }
+    }
+
+    while (ma_atomic_load_32(&g_throughputJobsProcessed) < THROUGHPUT_JOB_COUNT) {
+        ma_yield();
+    }
+
+    runTimeInSeconds = ma_timer_get_time_in_seconds(&timer);
+
+    ma_resource_manager_uninit(&resourceManager);
+
+    printf("    %2u threads: %10.0f jobs/sec\n", jobThreadCount, THROUGHPUT_JOB_COUNT / runTimeInSeconds);
+
+    if (g_throughputChecksum != expectedChecksum) {
+        printf("    Checksum mismatch. Some jobs were either lost or processed more than once.\n");
+        return MA_ERROR;
+    }
+
+    return MA_SUCCESS;
+}
+
+int test_entry__job_queue_throughput(int argc, char** argv)
+{
+    ma_result result;
+    ma_bool32 hasError = MA_FALSE;
+    ma_uint32 expectedChecksum;
+    ma_uint32 jobThreadCount;
+
+    (void)argc;
+    (void)argv;
+
+    expectedChecksum = test_job_queue_throughput__expected_checksum();
+
+    for (jobThreadCount = 1; jobThreadCount <= 32 && jobThreadCount <= MA_RESOURCE_MANAGER_MAX_JOB_THREAD_COUNT; jobThreadCount *= 2) {
+        result = test_job_queue_throughput__run(jobThreadCount, expectedChecksum);
+        if (result != MA_SUCCESS) {
+            hasError = MA_TRUE;
+        }
+    }
+
+    if (hasError) {
+        return -1;
+    }
+
+    return 0;
+}
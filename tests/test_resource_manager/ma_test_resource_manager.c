@@ -0,0 +1,441 @@
+#include "../test_common/ma_test_common.c"
+
+#include <errno.h>
+#if defined(_WIN32)
+#include <direct.h>
+#else
+#include <sys/stat.h>
+#endif
+
+/*
+Helpers shared by the resource manager tests. The tests generate all of their input files so they don't depend on anything other than
+what's in the repository. Each test keeps its files in its own folder under TEST_OUTPUT_DIR so that tests which look at everything in
+a folder, like the decoded cache, never see another test's files. Run the tests from the tests/_build folder.
+*/
+static ma_result test_resource_manager__create_directory(const char* pDirectory)
+{
+    int result;
+
+#if defined(_WIN32)
+    result = _mkdir(pDirectory);
+#else
+    result = mkdir(pDirectory, 0777);
+#endif
+
+    if (result != 0 && errno != EEXIST) {
+        printf("    Failed to create \"%s\".\n", pDirectory);
+        return MA_IO_ERROR;
+    }
+
+    return MA_SUCCESS;
+}
+
+/*
+The configuration most tests start from. A job thread count of 0 means MA_RESOURCE_MANAGER_FLAG_NO_THREADING, in which case the test
+processes jobs itself with test_resource_manager__pump().
+*/
+static ma_resource_manager_config test_resource_manager__config_init(ma_uint32 jobThreadCount)
+{
+    ma_resource_manager_config resourceManagerConfig;
+
+    resourceManagerConfig = ma_resource_manager_config_init();
+    resourceManagerConfig.decodedFormat  = ma_format_f32;
+    resourceManagerConfig.jobThreadCount = jobThreadCount;
+    if (jobThreadCount == 0) {
+        resourceManagerConfig.flags |= MA_RESOURCE_MANAGER_FLAG_NO_THREADING;
+    }
+
+    return resourceManagerConfig;
+}
+
+/* Called while waiting on the resource manager. Without threading nothing else is going to process the jobs. */
+static void test_resource_manager__pump(ma_resource_manager* pResourceManager)
+{
+    if ((pResourceManager->config.flags & MA_RESOURCE_MANAGER_FLAG_NO_THREADING) != 0) {
+        if (ma_resource_manager_process_next_job(pResourceManager) == MA_SUCCESS) {
+            return;
+        }
+    }
+
+    ma_sleep(1);
+}
+
+static ma_result test_resource_manager__wait_for_data_source(ma_resource_manager* pResourceManager, ma_resource_manager_data_source* pDataSource)
+{
+    ma_uint32 retryCount;
+
+    for (retryCount = 0; retryCount < 10000 && ma_resource_manager_data_source_result(pDataSource) == MA_BUSY; retryCount += 1) {
+        test_resource_manager__pump(pResourceManager);
+    }
+
+    return ma_resource_manager_data_source_result(pDataSource);
+}
+
+/* Prints the reason a test run failed, if any, and turns it into a result. */
+static ma_result test_resource_manager__report(const char* pErrorMessage)
+{
+    if (pErrorMessage != NULL) {
+        printf("    %s\n", pErrorMessage);
+        return MA_ERROR;
+    }
+
+    return MA_SUCCESS;
+}
+
+static ma_result test_resource_manager__write_wav(const char* pFilePath, ma_format format, ma_uint32 channels, ma_uint32 sampleRate, ma_uint64 frameCount)
+{
+    ma_result result;
+    ma_encoder_config encoderConfig;
+    ma_encoder encoder;
+    ma_noise_config noiseConfig;
+    ma_noise noise;
+    ma_uint8 buffer[4096];
+    ma_uint32 bufferCap = (ma_uint32)(sizeof(buffer) / ma_get_bytes_per_frame(format, channels));
+    ma_uint64 totalFramesWritten = 0;
+
+    /* Noise rather than a tone so that reading from the wrong place is always caught. The seed is fixed so the output is repeatable. */
+    noiseConfig = ma_noise_config_init(format, channels, ma_noise_type_white, 1234, 0.5);
+    result = ma_noise_init(&noiseConfig, NULL, &noise);
+    if (result != MA_SUCCESS) {
+        return result;
+    }
+
+    encoderConfig = ma_encoder_config_init(ma_encoding_format_wav, format, channels, sampleRate);
+    result = ma_encoder_init_file(pFilePath, &encoderConfig, &encoder);
+    if (result != MA_SUCCESS) {
+        ma_noise_uninit(&noise, NULL);
+        return result;
+    }
+
+    while (totalFramesWritten < frameCount) {
+        ma_uint64 framesToWrite = frameCount - totalFramesWritten;
+        ma_uint64 framesWritten;
+
+        if (framesToWrite > bufferCap) {
+            framesToWrite = bufferCap;
+        }
+
+        ma_noise_read_pcm_frames(&noise, buffer, framesToWrite, NULL);
+
+        result = ma_encoder_write_pcm_frames(&encoder, buffer, framesToWrite, &framesWritten);
+        if (result != MA_SUCCESS) {
+            break;
+        }
+
+        totalFramesWritten += framesWritten;
+    }
+
+    ma_encoder_uninit(&encoder);
+    ma_noise_uninit(&noise, NULL);
+
+    return result;
+}
+
+/*
+There's no MP3 encoder so MP3 files are put together by hand. Each frame is a 417 byte, 128 kbps, 44.1 kHz mono MPEG-1 Layer III frame
+with plausible side information and random main data, which the decoder turns into deterministic noise. main_data_begin is always 0
+so every frame can be decoded on its own.
+*/
+typedef struct
+{
+    ma_uint8* pData;
+    ma_uint32 bitCursor;
+} test_resource_manager_bit_writer;
+
+static void test_resource_manager__write_bits(test_resource_manager_bit_writer* pWriter, ma_uint32 value, ma_uint32 bitCount)
+{
+    while (bitCount > 0) {
+        bitCount -= 1;
+        if (((value >> bitCount) & 1) != 0) {
+            pWriter->pData[pWriter->bitCursor >> 3] |= (ma_uint8)(0x80 >> (pWriter->bitCursor & 7));
+        }
+
+        pWriter->bitCursor += 1;
+    }
+}
+
+static ma_uint32 test_resource_manager__random_range(ma_lcg* pLCG, ma_uint32 lo, ma_uint32 hi)
+{
+    return lo + (ma_lcg_rand_u32(pLCG) % (hi - lo + 1));
+}
+
+#define TEST_MP3_FRAME_SIZE_IN_BYTES    417
+
+static ma_result test_resource_manager__write_mp3(const char* pFilePath, ma_uint32 mp3FrameCount)
+{
+    static const ma_uint32 tableSelects[5] = { 1, 2, 5, 7, 13 };
+    ma_uint8 frame[TEST_MP3_FRAME_SIZE_IN_BYTES];
+    ma_lcg lcg;
+    ma_uint32 iFrame;
+    FILE* pFile;
+
+    pFile = fopen(pFilePath, "wb");
+    if (pFile == NULL) {
+        return MA_IO_ERROR;
+    }
+
+    ma_lcg_seed(&lcg, 4321);
+
+    for (iFrame = 0; iFrame < mp3FrameCount; iFrame += 1) {
+        test_resource_manager_bit_writer writer;
+        ma_uint32 iGranule;
+        ma_uint32 iByte;
+
+        MA_ZERO_MEMORY(frame, sizeof(frame));
+
+        /* MPEG-1, Layer III, no CRC, 128 kbps, 44.1 kHz, no padding, mono. */
+        frame[0] = 0xFF;
+        frame[1] = 0xFB;
+        frame[2] = 0x90;
+        frame[3] = 0xC4;
+
+        writer.pData     = frame + 4;
+        writer.bitCursor = 0;
+        test_resource_manager__write_bits(&writer, 0, 9);  /* main_data_begin */
+        test_resource_manager__write_bits(&writer, 0, 5);  /* private_bits */
+        test_resource_manager__write_bits(&writer, 0, 4);  /* scfsi */
+
+        for (iGranule = 0; iGranule < 2; iGranule += 1) {
+            ma_uint32 iRegion;
+
+            test_resource_manager__write_bits(&writer, test_resource_manager__random_range(&lcg, 200, 800), 12);   /* part2_3_length */
+            test_resource_manager__write_bits(&writer, test_resource_manager__random_range(&lcg,  20, 200),  9);   /* big_values */
+            test_resource_manager__write_bits(&writer, test_resource_manager__random_range(&lcg, 120, 170),  8);   /* global_gain */
+            test_resource_manager__write_bits(&writer, 0, 4);  /* scalefac_compress */
+            test_resource_manager__write_bits(&writer, 0, 1);  /* window_switching_flag */
+
+            for (iRegion = 0; iRegion < 3; iRegion += 1) {
+                test_resource_manager__write_bits(&writer, tableSelects[test_resource_manager__random_range(&lcg, 0, 4)], 5);
+            }
+
+            test_resource_manager__write_bits(&writer, test_resource_manager__random_range(&lcg, 0, 15), 4);       /* region0_count */
+            test_resource_manager__write_bits(&writer, test_resource_manager__random_range(&lcg, 0,  7), 3);       /* region1_count */
+            test_resource_manager__write_bits(&writer, 0, 3);  /* preflag, scalefac_scale, count1table_select */
+        }
+
+        /* The side information of a mono frame is 17 bytes. The rest is main data. */
+        for (iByte = 4 + 17; iByte < sizeof(frame); iByte += 1) {
+            frame[iByte] = (ma_uint8)ma_lcg_rand_u32(&lcg);
+        }
+
+        if (fwrite(frame, 1, sizeof(frame), pFile) != sizeof(frame)) {
+            fclose(pFile);
+            return MA_IO_ERROR;
+        }
+    }
+
+    fclose(pFile);
+
+    return MA_SUCCESS;
+}
+
+/*
+Decodes a whole file as f32 with a plain decoder. This is the reference the resource manager's output is compared against. Free the
+frames with ma_free().
+*/
+static ma_result test_resource_manager__decode_file(const char* pFilePath, ma_uint32 sampleRate, float** ppFrames, ma_uint64* pFrameCount, ma_uint32* pChannels)
+{
+    ma_result result;
+    ma_decoder_config decoderConfig;
+    ma_decoder decoder;
+
+    decoderConfig = ma_decoder_config_init(ma_format_f32, 0, sampleRate);
+
+    result = ma_decoder_init_file(pFilePath, &decoderConfig, &decoder);
+    if (result != MA_SUCCESS) {
+        return result;
+    }
+
+    *pChannels = decoder.outputChannels;
+
+    result = ma_decoder_get_length_in_pcm_frames(&decoder, pFrameCount);
+    if (result == MA_SUCCESS) {
+        *ppFrames = (float*)ma_malloc((size_t)(*pFrameCount * *pChannels * sizeof(float)), NULL);
+        if (*ppFrames == NULL) {
+            result = MA_OUT_OF_MEMORY;
+        } else {
+            result = ma_decoder_read_pcm_frames(&decoder, *ppFrames, *pFrameCount, pFrameCount);
+        }
+    }
+
+    ma_decoder_uninit(&decoder);
+
+    return result;
+}
+
+/*
+Reads up to frameCap f32 frames from a data source, waiting for asynchronously loaded data where necessary. Stops at the end or at the
+first error other than MA_BUSY.
+*/
+static ma_uint64 test_resource_manager__read_all(ma_data_source* pDataSource, float* pFrames, ma_uint32 channels, ma_uint64 frameCap)
+{
+    ma_uint64 totalFramesRead = 0;
+    ma_uint32 retryCount = 0;
+
+    while (totalFramesRead < frameCap && retryCount < 10000) {
+        ma_result result;
+        ma_uint64 framesRead;
+
+        result = ma_data_source_read_pcm_frames(pDataSource, pFrames + totalFramesRead*channels, frameCap - totalFramesRead, &framesRead);
+        totalFramesRead += framesRead;
+
+        if (result != MA_SUCCESS && result != MA_BUSY) {
+            break;
+        }
+
+        if (framesRead == 0) {
+            retryCount += 1;
+            ma_sleep(1);
+        }
+    }
+
+    return totalFramesRead;
+}
+
+/*
+Nodes that are released while a job thread is still finishing up with them are freed by a job, so memory usage can take a moment to
+come back down after uninitializing a data source.
+*/
+static ma_bool32 test_resource_manager__wait_for_memory_usage(ma_resource_manager* pResourceManager, ma_uint64 expectedMemoryUsage)
+{
+    ma_uint32 retryCount;
+
+    for (retryCount = 0; retryCount < 1000; retryCount += 1) {
+        if (ma_resource_manager_get_memory_usage_in_bytes(pResourceManager) == expectedMemoryUsage) {
+            return MA_TRUE;
+        }
+
+        test_resource_manager__pump(pResourceManager);
+    }
+
+    return MA_FALSE;
+}
+
+#include "ma_test_resource_manager_pak.c"
+#include "ma_test_resource_manager_decoded_cache.c"
+#include "ma_test_resource_manager_seek_table.c"
+#include "ma_test_resource_manager_manifest.c"
+#include "ma_test_resource_manager_stats.c"
+#include "ma_test_resource_manager_preroll.c"
+#include "ma_test_resource_manager_page_cache.c"
+#include "ma_test_resource_manager_adpcm.c"
+#include "ma_test_resource_manager_sniffing.c"
+#include "ma_test_resource_manager_parallel_flac.c"
+#include "ma_test_resource_manager_parallel_decode.c"
+#include "ma_test_resource_manager_async_read.c"
+#include "ma_test_resource_manager_memory_budget.c"
+#include "ma_test_resource_manager_mmap.c"
+#include "ma_test_resource_manager_in_place.c"
+#include "ma_test_resource_manager_hash_table.c"
+#include "ma_test_resource_manager_stream_pages.c"
+
+int main(int argc, char** argv)
+{
+    ma_result result;
+    ma_bool32 hasError = MA_FALSE;
+    size_t iTest;
+
+    (void)argc;
+    (void)argv;
+
+    result = ma_register_test("Pak", test_entry__resource_manager_pak);
+    if (result != MA_SUCCESS) {
+        return result;
+    }
+
+    result = ma_register_test("Decoded Cache", test_entry__resource_manager_decoded_cache);
+    if (result != MA_SUCCESS) {
+        return result;
+    }
+
+    result = ma_register_test("Seek Table", test_entry__resource_manager_seek_table);
+    if (result != MA_SUCCESS) {
+        return result;
+    }
+
+    result = ma_register_test("Manifest", test_entry__resource_manager_manifest);
+    if (result != MA_SUCCESS) {
+        return result;
+    }
+
+    result = ma_register_test("Stats", test_entry__resource_manager_stats);
+    if (result != MA_SUCCESS) {
+        return result;
+    }
+
+    result = ma_register_test("Preroll", test_entry__resource_manager_preroll);
+    if (result != MA_SUCCESS) {
+        return result;
+    }
+
+    result = ma_register_test("Page Cache", test_entry__resource_manager_page_cache);
+    if (result != MA_SUCCESS) {
+        return result;
+    }
+
+    result = ma_register_test("ADPCM", test_entry__resource_manager_adpcm);
+    if (result != MA_SUCCESS) {
+        return result;
+    }
+
+    result = ma_register_test("Sniffing", test_entry__resource_manager_sniffing);
+    if (result != MA_SUCCESS) {
+        return result;
+    }
+
+    result = ma_register_test("Parallel FLAC", test_entry__resource_manager_parallel_flac);
+    if (result != MA_SUCCESS) {
+        return result;
+    }
+
+    result = ma_register_test("Parallel Decode", test_entry__resource_manager_parallel_decode);
+    if (result != MA_SUCCESS) {
+        return result;
+    }
+
+    result = ma_register_test("Async Read", test_entry__resource_manager_async_read);
+    if (result != MA_SUCCESS) {
+        return result;
+    }
+
+    result = ma_register_test("Memory Budget", test_entry__resource_manager_memory_budget);
+    if (result != MA_SUCCESS) {
+        return result;
+    }
+
+    result = ma_register_test("Mmap", test_entry__resource_manager_mmap);
+    if (result != MA_SUCCESS) {
+        return result;
+    }
+
+    result = ma_register_test("In Place", test_entry__resource_manager_in_place);
+    if (result != MA_SUCCESS) {
+        return result;
+    }
+
+    result = ma_register_test("Hash Table", test_entry__resource_manager_hash_table);
+    if (result != MA_SUCCESS) {
+        return result;
+    }
+
+    result = ma_register_test("Stream Pages", test_entry__resource_manager_stream_pages);
+    if (result != MA_SUCCESS) {
+        return result;
+    }
+
+    for (iTest = 0; iTest < g_Tests.count; iTest += 1) {
+        printf("=== BEGIN %s ===\n", g_Tests.pTests[iTest].pName);
+        result = g_Tests.pTests[iTest].onEntry(argc, argv);
+        printf("=== END %s : %s ===\n", g_Tests.pTests[iTest].pName, (result == 0) ? "PASSED" : "FAILED");
+
+        if (result != 0) {
+            hasError = MA_TRUE;
+        }
+    }
+
+    if (hasError) {
+        return -1;  /* Something failed. */
+    } else {
+        return 0;   /* Everything passed. */
+    }
+}
@@ -0,0 +1,242 @@
+/* ADPCM is lossy so the round trip is judged by its signal to noise ratio rather than compared exactly. */
+#define ADPCM_TEST_DIRECTORY    TEST_OUTPUT_DIR"/adpcm"
+#define ADPCM_TEST_SINE_PATH    ADPCM_TEST_DIRECTORY"/sine.wav"
+#define ADPCM_TEST_NOISE_PATH   ADPCM_TEST_DIRECTORY"/noise.wav"
+
+static ma_result test_adpcm__write_sine(const char* pFilePath, ma_uint32 channels, ma_uint32 sampleRate, ma_uint64 frameCount)
+{
+    ma_result result;
+    ma_encoder_config encoderConfig;
+    ma_encoder encoder;
+    ma_waveform_config waveformConfig;
+    ma_waveform waveform;
+    ma_int16 buffer[4096];
+    ma_uint32 bufferCap = (ma_uint32)(ma_countof(buffer) / channels);
+    ma_uint64 totalFramesWritten = 0;
+
+    waveformConfig = ma_waveform_config_init(ma_format_s16, channels, sampleRate, ma_waveform_type_sine, 0.5, 440);
+    result = ma_waveform_init(&waveformConfig, &waveform);
+    if (result != MA_SUCCESS) {
+        return result;
+    }
+
+    encoderConfig = ma_encoder_config_init(ma_encoding_format_wav, ma_format_s16, channels, sampleRate);
+    result = ma_encoder_init_file(pFilePath, &encoderConfig, &encoder);
+    if (result != MA_SUCCESS) {
+        ma_waveform_uninit(&waveform);
+        return result;
+    }
+
+    while (totalFramesWritten < frameCount) {
+        ma_uint64 framesToWrite = frameCount - totalFramesWritten;
+        ma_uint64 framesWritten;
+
+        if (framesToWrite > bufferCap) {
+            framesToWrite = bufferCap;
+        }
+
+        ma_waveform_read_pcm_frames(&waveform, buffer, framesToWrite, NULL);
+
+        result = ma_encoder_write_pcm_frames(&encoder, buffer, framesToWrite, &framesWritten);
+        if (result != MA_SUCCESS) {
+            break;
+        }
+
+        totalFramesWritten += framesWritten;
+    }
+
+    ma_encoder_uninit(&encoder);
+    ma_waveform_uninit(&waveform);
+
+    return result;
+}
+
+static ma_result test_adpcm__run(const char* pFilePath, ma_uint32 flags, ma_format decodedFormat, ma_uint32 jobThreadCount, double minSignalToNoiseRatio)
+{
+    ma_result result;
+    ma_resource_manager_config resourceManagerConfig;
+    ma_resource_manager resourceManager;
+    ma_resource_manager_data_source dataSource;
+    float* pExpectedFrames;
+    float* pFrames = NULL;
+    float* pSeekedFrames = NULL;
+    ma_uint64 length;
+    ma_uint64 dataSourceLength;
+    ma_uint64 baselineMemoryUsage;
+    ma_uint64 adpcmSizeInBytes;
+    ma_uint64 cursor;
+    ma_uint64 availableFrames;
+    ma_uint64 framesRead;
+    ma_uint64 iSample;
+    ma_uint64 seekTarget;
+    ma_format format;
+    ma_uint32 channels;
+    ma_uint32 sampleRate;
+    double signalPower = 0;
+    double noisePower = 0;
+    double signalToNoiseRatio;
+    const char* pErrorMessage = NULL;
+
+    printf("    %s, flags 0x%x, %s, %u job threads\n", pFilePath, flags, ma_get_format_name(decodedFormat), jobThreadCount);
+
+    resourceManagerConfig = test_resource_manager__config_init(jobThreadCount);
+    resourceManagerConfig.decodedFormat = decodedFormat;
+
+    result = ma_resource_manager_init(&resourceManagerConfig, &resourceManager);
+    if (result != MA_SUCCESS) {
+        return result;
+    }
+
+    result = test_resource_manager__decode_file(pFilePath, 0, &pExpectedFrames, &length, &channels);
+    if (result != MA_SUCCESS) {
+        ma_resource_manager_uninit(&resourceManager);
+        return result;
+    }
+
+    baselineMemoryUsage = ma_resource_manager_get_memory_usage_in_bytes(&resourceManager);
+
+    if (ma_resource_manager_data_source_init(&resourceManager, pFilePath, flags | MA_RESOURCE_MANAGER_DATA_SOURCE_FLAG_ADPCM, NULL, &dataSource) != MA_SUCCESS) {
+        printf("    Failed to initialize the data source.\n");
+        ma_free(pExpectedFrames, NULL);
+        ma_resource_manager_uninit(&resourceManager);
+        return MA_ERROR;
+    }
+
+    if (test_resource_manager__wait_for_data_source(&resourceManager, &dataSource) != MA_SUCCESS) {
+        pErrorMessage = "Failed to load the file.";
+        goto done;
+    }
+
+    /* The blocks are decoded to s16 unless another format was asked for. */
+    ma_resource_manager_data_source_get_data_format(&dataSource, &format, &channels, &sampleRate, NULL, 0);
+    if (format != ((decodedFormat == ma_format_unknown) ? ma_format_s16 : decodedFormat)) {
+        pErrorMessage = "The data source has the wrong format.";
+        goto done;
+    }
+
+    if (ma_resource_manager_data_source_get_length_in_pcm_frames(&dataSource, &dataSourceLength) != MA_SUCCESS || dataSourceLength != length) {
+        pErrorMessage = "The data source has the wrong length.";
+        goto done;
+    }
+
+    /* A 4 byte header per block and channel plus 4 bits per sample, so a little over a quarter of s16. */
+    adpcmSizeInBytes = ma_resource_manager_get_memory_usage_in_bytes(&resourceManager) - baselineMemoryUsage;
+    if (adpcmSizeInBytes * 3 > length * channels * sizeof(ma_int16)) {
+        pErrorMessage = "The ADPCM data is too big.";
+        goto done;
+    }
+
+    if (format != ma_format_f32) {
+        goto done;
+    }
+
+    pFrames       = (float*)ma_malloc((size_t)(length * channels * sizeof(float)), NULL);
+    pSeekedFrames = (float*)ma_malloc((size_t)(5000 * channels * sizeof(float)), NULL);
+    if (pFrames == NULL || pSeekedFrames == NULL) {
+        pErrorMessage = "Out of memory.";
+        goto done;
+    }
+
+    framesRead = test_resource_manager__read_all(&dataSource, pFrames, channels, length);
+    if (framesRead != length) {
+        pErrorMessage = "Failed to read the whole file.";
+        goto done;
+    }
+
+    if (ma_resource_manager_data_source_read_pcm_frames(&dataSource, pSeekedFrames, 10, &framesRead) != MA_AT_END || framesRead != 0) {
+        pErrorMessage = "Reading past the end did not return MA_AT_END.";
+        goto done;
+    }
+
+    for (iSample = 0; iSample < length * channels; iSample += 1) {
+        double difference = (double)pFrames[iSample] - (double)pExpectedFrames[iSample];
+        signalPower += (double)pExpectedFrames[iSample] * (double)pExpectedFrames[iSample];
+        noisePower  += difference * difference;
+    }
+
+    signalToNoiseRatio = 10 * log10(signalPower / (noisePower + 1e-20));
+    if (signalToNoiseRatio < minSignalToNoiseRatio) {
+        printf("    SNR %.1f dB\n", signalToNoiseRatio);
+        pErrorMessage = "The round trip lost too much quality.";
+        goto done;
+    }
+
+    /* Seeking to the middle of a block decodes the block from the start, so it has to give exactly what sequential reading gave. */
+    seekTarget = MA_RESOURCE_MANAGER_ADPCM_BLOCK_SIZE_IN_FRAMES*3 + 333;
+    ma_resource_manager_data_source_seek_to_pcm_frame(&dataSource, seekTarget);
+    ma_resource_manager_data_source_get_cursor_in_pcm_frames(&dataSource, &cursor);
+    ma_resource_manager_data_source_get_available_frames(&dataSource, &availableFrames);
+
+    if (cursor != seekTarget || availableFrames != length - seekTarget) {
+        pErrorMessage = "Seeking did not update the cursor.";
+        goto done;
+    }
+
+    if (ma_resource_manager_data_source_read_pcm_frames(&dataSource, pSeekedFrames, 5000, &framesRead) != MA_SUCCESS || framesRead != 5000 ||
+        memcmp(pSeekedFrames, pFrames + seekTarget*channels, 5000 * channels * sizeof(float)) != 0) {
+        pErrorMessage = "Seeking into the middle of a block gave different frames to reading up to it.";
+        goto done;
+    }
+
+    if (ma_resource_manager_data_source_seek_to_pcm_frame(&dataSource, length + 1) == MA_SUCCESS) {
+        pErrorMessage = "Seeking past the end did not fail.";
+        goto done;
+    }
+
+done:
+    ma_resource_manager_data_source_uninit(&dataSource);
+
+    if (pErrorMessage == NULL && !test_resource_manager__wait_for_memory_usage(&resourceManager, baselineMemoryUsage)) {
+        pErrorMessage = "The ADPCM data was not freed with the data source.";
+    }
+
+    ma_resource_manager_uninit(&resourceManager);
+    ma_free(pSeekedFrames, NULL);
+    ma_free(pFrames, NULL);
+    ma_free(pExpectedFrames, NULL);
+
+    return test_resource_manager__report(pErrorMessage);
+}
+
+int test_entry__resource_manager_adpcm(int argc, char** argv)
+{
+    ma_bool32 hasError = MA_FALSE;
+
+    (void)argc;
+    (void)argv;
+
+    if (test_resource_manager__create_directory(ADPCM_TEST_DIRECTORY) != MA_SUCCESS ||
+        test_adpcm__write_sine(ADPCM_TEST_SINE_PATH, 2, 44100, 44100*2 + 77) != MA_SUCCESS ||
+        test_resource_manager__write_wav(ADPCM_TEST_NOISE_PATH, ma_format_s16, 1, 22050, 22050*2) != MA_SUCCESS) {
+        printf("    Failed to generate test files.\n");
+        return -1;
+    }
+
+    if (test_adpcm__run(ADPCM_TEST_SINE_PATH, 0, ma_format_f32, 1, 35) != MA_SUCCESS) {
+        hasError = MA_TRUE;
+    }
+
+    if (test_adpcm__run(ADPCM_TEST_SINE_PATH, MA_RESOURCE_MANAGER_DATA_SOURCE_FLAG_ASYNC, ma_format_f32, 3, 35) != MA_SUCCESS) {
+        hasError = MA_TRUE;
+    }
+
+    /* White noise is the worst case for ADPCM so this only checks that it's in the right ballpark. */
+    if (test_adpcm__run(ADPCM_TEST_NOISE_PATH, MA_RESOURCE_MANAGER_DATA_SOURCE_FLAG_ASYNC, ma_format_f32, 2, 10) != MA_SUCCESS) {
+        hasError = MA_TRUE;
+    }
+
+    /* ADPCM takes priority over DECODE. */
+    if (test_adpcm__run(ADPCM_TEST_SINE_PATH, MA_RESOURCE_MANAGER_DATA_SOURCE_FLAG_ASYNC | MA_RESOURCE_MANAGER_DATA_SOURCE_FLAG_DECODE, ma_format_f32, 0, 35) != MA_SUCCESS) {
+        hasError = MA_TRUE;
+    }
+
+    if (test_adpcm__run(ADPCM_TEST_NOISE_PATH, 0, ma_format_unknown, 1, 0) != MA_SUCCESS) {
+        hasError = MA_TRUE;
+    }
+
+    if (hasError) {
+        return -1;
+    }
+
+    return 0;
+}
@@ -0,0 +1,242 @@
+/*
+Decoders opened through a VFS with asynchronous reads read ahead of themselves. What they decode, including after seeking inside the
+current chunk and past it, has to be exactly what a decoder reading the file directly gives.
+*/
+#define ASYNC_READ_TEST_DIRECTORY   TEST_OUTPUT_DIR"/async_read"
+#define ASYNC_READ_TEST_WAV_PATH    ASYNC_READ_TEST_DIRECTORY"/test.wav"
+#define ASYNC_READ_TEST_MP3_PATH    ASYNC_READ_TEST_DIRECTORY"/test.mp3"
+
+/*
+Reads submitted to this VFS aren't done until they're waited on, so anything that reads the destination too early, or forgets to wait,
+gets caught. The file's cursor is left where it was, like a real asynchronous read.
+*/
+typedef struct
+{
+    ma_default_vfs base;
+    ma_uint32 submitCount;
+    ma_uint32 waitCount;
+} test_async_read_deferred_vfs;
+
+static ma_result test_async_read__deferred_submit_read(ma_vfs* pVFS, ma_vfs_file file, ma_vfs_read_request* pRequest)
+{
+    (void)file;
+
+    ((test_async_read_deferred_vfs*)pVFS)->submitCount += 1;
+    ma_atomic_exchange_i32(&pRequest->result, MA_BUSY);
+
+    return MA_SUCCESS;
+}
+
+static ma_result test_async_read__deferred_wait_read(ma_vfs* pVFS, ma_vfs_file file, ma_vfs_read_request* pRequest)
+{
+    ma_result result;
+    ma_int64 cursor;
+
+    ((test_async_read_deferred_vfs*)pVFS)->waitCount += 1;
+
+    result = ma_vfs_tell(pVFS, file, &cursor);
+    if (result == MA_SUCCESS) {
+        result = ma_vfs_seek(pVFS, file, (ma_int64)pRequest->offset, ma_seek_origin_start);
+    }
+
+    if (result == MA_SUCCESS) {
+        result = ma_vfs_read(pVFS, file, pRequest->pDst, pRequest->sizeInBytes, &pRequest->bytesRead);
+        if (result == MA_AT_END) {
+            result = MA_SUCCESS;
+        }
+
+        ma_vfs_seek(pVFS, file, cursor, ma_seek_origin_start);
+    }
+
+    ma_atomic_exchange_i32(&pRequest->result, result);
+
+    return MA_SUCCESS;
+}
+
+/* Reads frameCount frames starting at frameIndex and compares them against the same frames of the reference. */
+static ma_result test_async_read__compare(ma_decoder* pDecoder, ma_uint64 frameIndex, ma_uint64 frameCount, const float* pExpectedFrames, ma_uint64 expectedLength, ma_uint32 channels)
+{
+    float frames[4096];
+    ma_uint64 expectedFrameCount;
+    ma_uint64 framesRead;
+
+    MA_ASSERT(frameCount * channels <= ma_countof(frames));
+
+    if (ma_decoder_seek_to_pcm_frame(pDecoder, frameIndex) != MA_SUCCESS) {
+        return MA_ERROR;
+    }
+
+    expectedFrameCount = frameCount;
+    if (expectedFrameCount > expectedLength - frameIndex) {
+        expectedFrameCount = expectedLength - frameIndex;
+    }
+
+    ma_decoder_read_pcm_frames(pDecoder, frames, frameCount, &framesRead);
+    if (framesRead != expectedFrameCount || memcmp(frames, pExpectedFrames + frameIndex*channels, (size_t)(framesRead * channels * sizeof(float))) != 0) {
+        return MA_ERROR;
+    }
+
+    return MA_SUCCESS;
+}
+
+static ma_result test_async_read__check(ma_vfs* pVFS, const char* pFilePath, ma_bool32 expectReadAhead)
+{
+    ma_result result;
+    ma_decoder_config decoderConfig;
+    ma_decoder decoder;
+    float* pExpectedFrames;
+    float* pFrames = NULL;
+    ma_uint64 expectedLength;
+    ma_uint64 framesRead;
+    ma_uint64 bytesPerFrame;
+    ma_uint64 chunkSizeInFrames;
+    ma_uint32 channels;
+    const char* pErrorMessage = NULL;
+
+    result = test_resource_manager__decode_file(pFilePath, 0, &pExpectedFrames, &expectedLength, &channels);
+    if (result != MA_SUCCESS) {
+        printf("    Failed to decode the reference.\n");
+        return result;
+    }
+
+    decoderConfig = ma_decoder_config_init(ma_format_f32, 0, 0);
+
+    result = ma_decoder_init_vfs(pVFS, pFilePath, &decoderConfig, &decoder);
+    if (result != MA_SUCCESS) {
+        printf("    Failed to open the decoder.\n");
+        ma_free(pExpectedFrames, NULL);
+        return result;
+    }
+
+    if ((decoder.data.vfs.pReadAhead != NULL) != expectReadAhead) {
+        pErrorMessage = expectReadAhead ? "The decoder is not reading ahead." : "The decoder is reading ahead without asynchronous reads.";
+        goto done;
+    }
+
+    /* The whole file from the start. */
+    pFrames = (float*)ma_malloc((size_t)(expectedLength * channels * sizeof(float)), NULL);
+    if (pFrames == NULL) {
+        pErrorMessage = "Out of memory.";
+        goto done;
+    }
+
+    ma_decoder_read_pcm_frames(&decoder, pFrames, expectedLength, &framesRead);
+    if (framesRead != expectedLength || memcmp(pFrames, pExpectedFrames, (size_t)(framesRead * channels * sizeof(float))) != 0) {
+        pErrorMessage = "Reading the whole file gave different frames.";
+        goto done;
+    }
+
+    /*
+    Roughly how many frames fit in a chunk of the read-ahead. It's only a guide for picking seek targets. Compressed formats get more
+    frames into a chunk, which only makes the "inside the chunk" seeks land further inside it.
+    */
+    bytesPerFrame     = ma_get_bytes_per_frame(ma_format_s16, channels);
+    chunkSizeInFrames = MA_DECODER_READ_AHEAD_CHUNK_SIZE_IN_BYTES / bytesPerFrame;
+
+    /* Back to the start and forward a little, which stays inside the first chunk. */
+    if (test_async_read__compare(&decoder, 0, 1000, pExpectedFrames, expectedLength, channels) != MA_SUCCESS ||
+        test_async_read__compare(&decoder, 500, 1000, pExpectedFrames, expectedLength, channels) != MA_SUCCESS ||
+        test_async_read__compare(&decoder, 100, 500, pExpectedFrames, expectedLength, channels) != MA_SUCCESS) {
+        pErrorMessage = "A seek inside the read-ahead chunk gave different frames.";
+        goto done;
+    }
+
+    /* Reading across the end of the chunk, then seeking well past it and back again. */
+    if (test_async_read__compare(&decoder, chunkSizeInFrames - 500, 1000, pExpectedFrames, expectedLength, channels) != MA_SUCCESS ||
+        test_async_read__compare(&decoder, chunkSizeInFrames * 5 + 123, 1000, pExpectedFrames, expectedLength, channels) != MA_SUCCESS ||
+        test_async_read__compare(&decoder, chunkSizeInFrames * 2, 1000, pExpectedFrames, expectedLength, channels) != MA_SUCCESS ||
+        test_async_read__compare(&decoder, 10, 1000, pExpectedFrames, expectedLength, channels) != MA_SUCCESS) {
+        pErrorMessage = "A seek outside the read-ahead chunk gave different frames.";
+        goto done;
+    }
+
+    /* Up to and past the end of the file. */
+    if (test_async_read__compare(&decoder, expectedLength - 100, 1000, pExpectedFrames, expectedLength, channels) != MA_SUCCESS) {
+        pErrorMessage = "Reading up to the end of the file gave different frames.";
+        goto done;
+    }
+
+done:
+    ma_decoder_uninit(&decoder);
+    ma_free(pFrames, NULL);
+    ma_free(pExpectedFrames, NULL);
+
+    return test_resource_manager__report(pErrorMessage);
+}
+
+int test_entry__resource_manager_async_read(int argc, char** argv)
+{
+    static const char* pFilePaths[] = {
+        ASYNC_READ_TEST_WAV_PATH,
+        ASYNC_READ_TEST_MP3_PATH
+    };
+    ma_bool32 hasError = MA_FALSE;
+    ma_io_uring_vfs uringVFS;
+    test_async_read_deferred_vfs deferredVFS;
+    ma_vfs_ex_callbacks exCallbacks;
+    ma_extended_vfs extendedVFS;
+    void* pRing;
+    size_t iFile;
+
+    (void)argc;
+    (void)argv;
+
+    /* Long enough to need a good number of read-ahead chunks. */
+    if (test_resource_manager__create_directory(ASYNC_READ_TEST_DIRECTORY) != MA_SUCCESS ||
+        test_resource_manager__write_wav(ASYNC_READ_TEST_WAV_PATH, ma_format_s16, 2, 44100, 44100*3) != MA_SUCCESS ||
+        test_resource_manager__write_mp3(ASYNC_READ_TEST_MP3_PATH, 1000) != MA_SUCCESS) {
+        printf("    Failed to generate test files.\n");
+        return -1;
+    }
+
+    if (ma_io_uring_vfs_init(&uringVFS, NULL) != MA_SUCCESS) {
+        printf("    Failed to initialize the io_uring VFS.\n");
+        return -1;
+    }
+
+    ma_default_vfs_init(&deferredVFS.base, NULL);
+    deferredVFS.submitCount = 0;
+    deferredVFS.waitCount   = 0;
+
+    MA_ZERO_OBJECT(&exCallbacks);
+    exCallbacks.sizeInBytes  = sizeof(exCallbacks);
+    exCallbacks.onSubmitRead = test_async_read__deferred_submit_read;
+    exCallbacks.onWaitRead   = test_async_read__deferred_wait_read;
+    ma_extended_vfs_init((ma_vfs*)&deferredVFS, &exCallbacks, &extendedVFS);
+
+    for (iFile = 0; iFile < ma_countof(pFilePaths); iFile += 1) {
+        /* Not every kernel has io_uring, or allows it, in which case this ends up being the same as the fallback below. */
+        printf("    %s through ma_io_uring_vfs (%s)\n", pFilePaths[iFile], (uringVFS.pRing != NULL) ? "io_uring" : "no io_uring");
+        if (test_async_read__check((ma_vfs*)&uringVFS, pFilePaths[iFile], uringVFS.pRing != NULL) != MA_SUCCESS) {
+            hasError = MA_TRUE;
+        }
+
+        printf("    %s through ma_extended_vfs\n", pFilePaths[iFile]);
+        if (test_async_read__check((ma_vfs*)&extendedVFS, pFilePaths[iFile], MA_TRUE) != MA_SUCCESS) {
+            hasError = MA_TRUE;
+        }
+
+        /* What happens when the ring can't be set up. Reads are done synchronously and the decoder doesn't read ahead. */
+        printf("    %s through ma_io_uring_vfs without a ring\n", pFilePaths[iFile]);
+        pRing = uringVFS.pRing;
+        uringVFS.pRing = NULL;
+        if (test_async_read__check((ma_vfs*)&uringVFS, pFilePaths[iFile], MA_FALSE) != MA_SUCCESS) {
+            hasError = MA_TRUE;
+        }
+        uringVFS.pRing = pRing;
+    }
+
+    /* Every read that was started has to have been finished, including those still in flight when a decoder seeked or was closed. */
+    if (deferredVFS.submitCount == 0 || deferredVFS.submitCount != deferredVFS.waitCount) {
+        printf("    %u reads were submitted but %u were waited on.\n", deferredVFS.submitCount, deferredVFS.waitCount);
+        hasError = MA_TRUE;
+    }
+
+    ma_io_uring_vfs_uninit(&uringVFS);
+
+    if (hasError) {
+        return -1;
+    }
+
+    return 0;
+}
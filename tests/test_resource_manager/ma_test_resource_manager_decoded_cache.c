@@ -0,0 +1,267 @@
+/*
+The first load of a sound decodes it and writes it to the cache, and the second maps it out of the cache. Either way the audio has to be
+the same as decoding without a cache, and a cache file must never be used for a file or configuration it wasn't made from.
+*/
+#define DECODED_CACHE_TEST_DIRECTORY        TEST_OUTPUT_DIR"/decoded_cache"
+#define DECODED_CACHE_TEST_CACHE_DIRECTORY  DECODED_CACHE_TEST_DIRECTORY"/cache"
+#define DECODED_CACHE_TEST_PATH             DECODED_CACHE_TEST_DIRECTORY"/test.wav"
+
+typedef struct
+{
+    float* pFrames;
+    ma_uint64 frameCount;
+    ma_bool32 isMapped;         /* True if the sound was mapped out of the cache rather than decoded. */
+    ma_uint64 decodedBytes;
+} test_decoded_cache_load_result;
+
+static ma_result test_decoded_cache__load(const char* pCacheDirectory, ma_uint64 cacheMaxSizeInBytes, ma_uint32 sampleRate, ma_uint32 flags, test_decoded_cache_load_result* pResult)
+{
+    ma_result result;
+    ma_resource_manager_config resourceManagerConfig;
+    ma_resource_manager resourceManager;
+    ma_resource_manager_data_source dataSource;
+    ma_resource_manager_stats stats;
+    ma_uint64 length;
+    ma_uint32 channels;
+
+    MA_ZERO_OBJECT(pResult);
+
+    resourceManagerConfig = test_resource_manager__config_init(1);
+    resourceManagerConfig.decodedSampleRate          = sampleRate;
+    resourceManagerConfig.pDecodedCacheDirectory     = pCacheDirectory;
+    resourceManagerConfig.decodedCacheMaxSizeInBytes = cacheMaxSizeInBytes;
+
+    result = ma_resource_manager_init(&resourceManagerConfig, &resourceManager);
+    if (result != MA_SUCCESS) {
+        return result;
+    }
+
+    result = ma_resource_manager_data_source_init(&resourceManager, DECODED_CACHE_TEST_PATH, flags, NULL, &dataSource);
+    if (result != MA_SUCCESS) {
+        ma_resource_manager_uninit(&resourceManager);
+        return result;
+    }
+
+    test_resource_manager__wait_for_data_source(&resourceManager, &dataSource);
+    ma_data_source_get_data_format(&dataSource, NULL, &channels, NULL, NULL, 0);
+
+    result = ma_resource_manager_data_source_get_length_in_pcm_frames(&dataSource, &length);
+    if (result == MA_SUCCESS) {
+        pResult->isMapped = (dataSource.backend.buffer.pNode->data.backend.decoded.file != NULL);
+        pResult->pFrames  = (float*)ma_malloc((size_t)(length * channels * sizeof(float)), NULL);
+        if (pResult->pFrames == NULL) {
+            result = MA_OUT_OF_MEMORY;
+        } else {
+            pResult->frameCount = test_resource_manager__read_all(&dataSource, pResult->pFrames, channels, length);
+        }
+    }
+
+    ma_resource_manager_data_source_uninit(&dataSource);
+
+    /* Mapping a cache file doesn't decode anything. */
+    ma_resource_manager_get_stats(&resourceManager, &stats);
+    pResult->decodedBytes = stats.decodedBytes;
+
+    ma_resource_manager_uninit(&resourceManager);
+
+    return result;
+}
+
+/* Deletes every cache file by trimming the cache with a tiny limit. */
+static ma_uint64 test_decoded_cache__clear(void)
+{
+    ma_resource_manager_config resourceManagerConfig;
+    ma_resource_manager resourceManager;
+    ma_uint64 sizeInBytes;
+
+    resourceManagerConfig = ma_resource_manager_config_init();
+    resourceManagerConfig.pDecodedCacheDirectory     = DECODED_CACHE_TEST_CACHE_DIRECTORY;
+    resourceManagerConfig.decodedCacheMaxSizeInBytes = 1;
+
+    if (ma_resource_manager_init(&resourceManagerConfig, &resourceManager) != MA_SUCCESS) {
+        return ~(ma_uint64)0;
+    }
+
+    sizeInBytes = ma_atomic_load_64(&resourceManager.decodedCacheSizeInBytes);
+    ma_resource_manager_uninit(&resourceManager);
+
+    return sizeInBytes;
+}
+
+/*
+Changes some of the audio without changing the size of the file. This happens straight after the file was loaded, so when the file
+system only has whole second modification times the file looks the same as before by its size and modification time.
+*/
+static ma_result test_decoded_cache__modify_in_place(void)
+{
+    FILE* pFile;
+    ma_uint8 data[256];
+    size_t iByte;
+
+    pFile = fopen(DECODED_CACHE_TEST_PATH, "r+b");
+    if (pFile == NULL) {
+        return MA_IO_ERROR;
+    }
+
+    for (iByte = 0; iByte < sizeof(data); iByte += 1) {
+        data[iByte] = (ma_uint8)(iByte * 37);
+    }
+
+    /* Well past the header. */
+    if (fseek(pFile, 4096, SEEK_SET) != 0 || fwrite(data, 1, sizeof(data), pFile) != sizeof(data)) {
+        fclose(pFile);
+        return MA_IO_ERROR;
+    }
+
+    fclose(pFile);
+
+    return MA_SUCCESS;
+}
+
+static ma_bool32 test_decoded_cache__is_same(const test_decoded_cache_load_result* pA, const test_decoded_cache_load_result* pB)
+{
+    return pA->frameCount > 0 && pA->frameCount == pB->frameCount && memcmp(pA->pFrames, pB->pFrames, (size_t)(pA->frameCount * 2 * sizeof(float))) == 0;
+}
+
+static ma_result test_decoded_cache__run(ma_uint32 sampleRate, ma_uint32 flags)
+{
+    ma_result result = MA_ERROR;
+    test_decoded_cache_load_result reference;
+    test_decoded_cache_load_result miss;
+    test_decoded_cache_load_result hit;
+    test_decoded_cache_load_result other;
+    test_decoded_cache_load_result modified;
+
+    MA_ZERO_OBJECT(&miss);
+    MA_ZERO_OBJECT(&hit);
+    MA_ZERO_OBJECT(&other);
+    MA_ZERO_OBJECT(&modified);
+
+    printf("    %u Hz, flags 0x%x\n", sampleRate, flags);
+
+    if (test_resource_manager__write_wav(DECODED_CACHE_TEST_PATH, ma_format_s16, 2, 44100, 40000) != MA_SUCCESS) {
+        printf("    Failed to generate the test file.\n");
+        return MA_ERROR;
+    }
+
+    if (test_decoded_cache__load(NULL, 0, sampleRate, flags, &reference) != MA_SUCCESS) {
+        printf("    Failed to load without the cache.\n");
+        return MA_ERROR;
+    }
+
+    test_decoded_cache__clear();
+
+    if (test_decoded_cache__load(DECODED_CACHE_TEST_CACHE_DIRECTORY, 0, sampleRate, flags, &miss) != MA_SUCCESS || miss.isMapped || miss.decodedBytes == 0 || !test_decoded_cache__is_same(&miss, &reference)) {
+        printf("    The first load was not decoded normally.\n");
+        goto done;
+    }
+
+    if (test_decoded_cache__load(DECODED_CACHE_TEST_CACHE_DIRECTORY, 0, sampleRate, flags, &hit) != MA_SUCCESS || !hit.isMapped || hit.decodedBytes != 0 || !test_decoded_cache__is_same(&hit, &reference)) {
+        printf("    The second load was not mapped from the cache, or the cached audio is different.\n");
+        goto done;
+    }
+
+    /* A different decoding configuration must not pick up the cache file. */
+    if (test_decoded_cache__load(DECODED_CACHE_TEST_CACHE_DIRECTORY, 0, (sampleRate == 0) ? 32000 : 0, flags, &other) != MA_SUCCESS || other.isMapped) {
+        printf("    A different sample rate was served from the cache.\n");
+        goto done;
+    }
+
+    ma_free(hit.pFrames, NULL);
+    ma_free(other.pFrames, NULL);
+    MA_ZERO_OBJECT(&hit);
+    MA_ZERO_OBJECT(&other);
+
+    /* A modified file must be decoded again, first with a different size and then with the same size. */
+    if (test_resource_manager__write_wav(DECODED_CACHE_TEST_PATH, ma_format_s16, 2, 44100, 30000) != MA_SUCCESS ||
+        test_decoded_cache__load(NULL, 0, sampleRate, flags, &other) != MA_SUCCESS) {
+        printf("    Failed to load the modified file without the cache.\n");
+        goto done;
+    }
+
+    if (test_decoded_cache__load(DECODED_CACHE_TEST_CACHE_DIRECTORY, 0, sampleRate, flags, &hit) != MA_SUCCESS || hit.isMapped || !test_decoded_cache__is_same(&hit, &other)) {
+        printf("    A modified file was served from a stale cache file.\n");
+        goto done;
+    }
+
+    ma_free(hit.pFrames, NULL);
+    MA_ZERO_OBJECT(&hit);
+
+    if (test_decoded_cache__modify_in_place() != MA_SUCCESS ||
+        test_decoded_cache__load(NULL, 0, sampleRate, flags, &modified) != MA_SUCCESS || modified.frameCount != other.frameCount || test_decoded_cache__is_same(&modified, &other)) {
+        printf("    Failed to modify the file in place.\n");
+        goto done;
+    }
+
+    if (test_decoded_cache__load(DECODED_CACHE_TEST_CACHE_DIRECTORY, 0, sampleRate, flags, &hit) != MA_SUCCESS || hit.isMapped || !test_decoded_cache__is_same(&hit, &modified)) {
+        printf("    A file rewritten with the same size was served from a stale cache file.\n");
+        goto done;
+    }
+
+    result = MA_SUCCESS;
+
+done:
+    ma_free(reference.pFrames, NULL);
+    ma_free(miss.pFrames, NULL);
+    ma_free(hit.pFrames, NULL);
+    ma_free(other.pFrames, NULL);
+    ma_free(modified.pFrames, NULL);
+
+    return result;
+}
+
+int test_entry__resource_manager_decoded_cache(int argc, char** argv)
+{
+    ma_bool32 hasError = MA_FALSE;
+    test_decoded_cache_load_result result;
+
+    (void)argc;
+    (void)argv;
+
+    if (test_resource_manager__create_directory(DECODED_CACHE_TEST_DIRECTORY) != MA_SUCCESS ||
+        test_resource_manager__create_directory(DECODED_CACHE_TEST_CACHE_DIRECTORY) != MA_SUCCESS) {
+        return -1;
+    }
+
+    if (test_decoded_cache__run(0, MA_RESOURCE_MANAGER_DATA_SOURCE_FLAG_DECODE) != MA_SUCCESS) {
+        hasError = MA_TRUE;
+    }
+
+    if (test_decoded_cache__run(0, MA_RESOURCE_MANAGER_DATA_SOURCE_FLAG_DECODE | MA_RESOURCE_MANAGER_DATA_SOURCE_FLAG_ASYNC) != MA_SUCCESS) {
+        hasError = MA_TRUE;
+    }
+
+    if (test_decoded_cache__run(48000, MA_RESOURCE_MANAGER_DATA_SOURCE_FLAG_DECODE) != MA_SUCCESS) {
+        hasError = MA_TRUE;
+    }
+
+    /* Trimming. The directory is listed when the resource manager is initialized so a limit lower than anything in it deletes it all. */
+#if defined(MA_HAS_DECODED_CACHE_TRIMMING)
+    {
+        if (test_decoded_cache__load(DECODED_CACHE_TEST_CACHE_DIRECTORY, 0, 0, MA_RESOURCE_MANAGER_DATA_SOURCE_FLAG_DECODE, &result) == MA_SUCCESS) {
+            ma_free(result.pFrames, NULL);
+        }
+
+        if (test_decoded_cache__clear() != 0) {
+            printf("    The cache was not trimmed.\n");
+            hasError = MA_TRUE;
+        }
+
+        if (test_decoded_cache__load(DECODED_CACHE_TEST_CACHE_DIRECTORY, 0, 0, MA_RESOURCE_MANAGER_DATA_SOURCE_FLAG_DECODE, &result) != MA_SUCCESS || result.isMapped) {
+            printf("    A trimmed cache file was still used.\n");
+            hasError = MA_TRUE;
+        }
+
+        ma_free(result.pFrames, NULL);
+        test_decoded_cache__clear();
+    }
+#else
+    (void)result;
+#endif
+
+    if (hasError) {
+        return -1;
+    }
+
+    return 0;
+}
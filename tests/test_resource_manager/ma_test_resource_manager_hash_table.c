@@ -0,0 +1,365 @@
+/*
+Data buffer nodes live in a hash table split into independently locked shards. Names that land in the same shard, or that hash to the
+exact same value, must never be confused for each other, and threads acquiring and releasing nodes at the same time must always get
+back the node they asked for.
+*/
+#define HASH_TABLE_TEST_SEARCH_COUNT        400000  /* Enough names for a full 32-bit hash collision to be all but certain. */
+#define HASH_TABLE_TEST_SAME_SHARD_COUNT    100     /* Enough to make the shard grow its buckets a few times. */
+#define HASH_TABLE_TEST_SHARED_NAME_COUNT   64
+#define HASH_TABLE_TEST_THREAD_COUNT        8
+#define HASH_TABLE_TEST_ITERATION_COUNT     2000
+#define HASH_TABLE_TEST_MAX_NAME_LENGTH     32
+
+typedef struct
+{
+    ma_uint32 hashedName32;
+    ma_uint32 index;
+} test_hash_table_entry;
+
+static int test_hash_table__compare_entries(const void* a, const void* b)
+{
+    const test_hash_table_entry* pA = (const test_hash_table_entry*)a;
+    const test_hash_table_entry* pB = (const test_hash_table_entry*)b;
+
+    if (pA->hashedName32 != pB->hashedName32) {
+        return (pA->hashedName32 < pB->hashedName32) ? -1 : 1;
+    }
+
+    return (pA->index < pB->index) ? -1 : ((pA->index > pB->index) ? 1 : 0);
+}
+
+static ma_uint32 test_hash_table__get_node_count(ma_resource_manager* pResourceManager)
+{
+    ma_uint32 nodeCount = 0;
+    ma_uint32 iShard;
+
+    for (iShard = 0; iShard < ma_countof(pResourceManager->dataBufferShards); iShard += 1) {
+        nodeCount += pResourceManager->dataBufferShards[iShard].nodeCount;
+    }
+
+    return nodeCount;
+}
+
+/* Loads a registered name and checks that it's the one-frame sound holding the expected value. */
+static ma_bool32 test_hash_table__is_named(ma_resource_manager* pResourceManager, const char* pName, float expectedValue)
+{
+    ma_resource_manager_data_buffer dataBuffer;
+    float value = 0;
+    ma_uint64 framesRead = 0;
+
+    if (ma_resource_manager_data_buffer_init(pResourceManager, pName, 0, NULL, &dataBuffer) != MA_SUCCESS) {
+        return MA_FALSE;
+    }
+
+    ma_resource_manager_data_buffer_read_pcm_frames(&dataBuffer, &value, 1, &framesRead);
+    ma_resource_manager_data_buffer_uninit(&dataBuffer);
+
+    return framesRead == 1 && value == expectedValue;
+}
+
+/* Two names that hash to the same value, plus a crowd of names that share their shard, all registered at once. */
+static ma_result test_hash_table__collisions(void)
+{
+    ma_result result;
+    ma_resource_manager_config resourceManagerConfig;
+    ma_resource_manager resourceManager;
+    ma_resource_manager_data_buffer_shard* pShard;
+    test_hash_table_entry* pEntries;
+    char names[HASH_TABLE_TEST_SAME_SHARD_COUNT + 2][HASH_TABLE_TEST_MAX_NAME_LENGTH];
+    float values[HASH_TABLE_TEST_SAME_SHARD_COUNT + 2];
+    ma_uint32 nameCount = 0;
+    ma_uint32 registeredCount = 0;
+    ma_uint32 shardIndex;
+    ma_uint32 iName;
+    const char* pErrorMessage = NULL;
+
+    pEntries = (test_hash_table_entry*)ma_malloc(HASH_TABLE_TEST_SEARCH_COUNT * sizeof(*pEntries), NULL);
+    if (pEntries == NULL) {
+        return MA_OUT_OF_MEMORY;
+    }
+
+    for (iName = 0; iName < HASH_TABLE_TEST_SEARCH_COUNT; iName += 1) {
+        sprintf(names[0], "collision_%u", iName);
+        pEntries[iName].hashedName32 = ma_hash_string_32(names[0]);
+        pEntries[iName].index        = iName;
+    }
+
+    qsort(pEntries, HASH_TABLE_TEST_SEARCH_COUNT, sizeof(*pEntries), test_hash_table__compare_entries);
+
+    for (iName = 1; iName < HASH_TABLE_TEST_SEARCH_COUNT; iName += 1) {
+        if (pEntries[iName].hashedName32 == pEntries[iName - 1].hashedName32) {
+            sprintf(names[0], "collision_%u", pEntries[iName - 1].index);
+            sprintf(names[1], "collision_%u", pEntries[iName].index);
+            nameCount = 2;
+            break;
+        }
+    }
+
+    ma_free(pEntries, NULL);
+
+    if (nameCount != 2) {
+        printf("    No two names hashed to the same value.\n");
+        return MA_ERROR;
+    }
+
+    printf("    \"%s\" and \"%s\" both hash to 0x%08X\n", names[0], names[1], ma_hash_string_32(names[0]));
+
+    shardIndex = ma_hash_string_32(names[0]) & (MA_RESOURCE_MANAGER_DATA_BUFFER_SHARD_COUNT - 1);
+
+    for (iName = 0; nameCount < ma_countof(names); iName += 1) {
+        sprintf(names[nameCount], "same_shard_%u", iName);
+        if ((ma_hash_string_32(names[nameCount]) & (MA_RESOURCE_MANAGER_DATA_BUFFER_SHARD_COUNT - 1)) == shardIndex) {
+            nameCount += 1;
+        }
+    }
+
+    resourceManagerConfig = test_resource_manager__config_init(0);
+
+    result = ma_resource_manager_init(&resourceManagerConfig, &resourceManager);
+    if (result != MA_SUCCESS) {
+        printf("    Failed to initialize the resource manager.\n");
+        return result;
+    }
+
+    pShard = &resourceManager.dataBufferShards[shardIndex];
+
+    for (registeredCount = 0; registeredCount < nameCount; registeredCount += 1) {
+        values[registeredCount] = (float)(registeredCount + 1);
+
+        if (ma_resource_manager_register_decoded_data(&resourceManager, names[registeredCount], &values[registeredCount], 1, ma_format_f32, 1, 48000) != MA_SUCCESS) {
+            pErrorMessage = "Failed to register data.";
+            goto done;
+        }
+    }
+
+    if (pShard->nodeCount != nameCount || test_hash_table__get_node_count(&resourceManager) != nameCount) {
+        pErrorMessage = "The names were not all put in the same shard.";
+        goto done;
+    }
+
+    if (pShard->bucketCount < nameCount) {
+        pErrorMessage = "The shard did not grow.";
+        goto done;
+    }
+
+    for (iName = 0; iName < nameCount; iName += 1) {
+        if (!test_hash_table__is_named(&resourceManager, names[iName], values[iName])) {
+            pErrorMessage = "A name gave back another name's data.";
+            goto done;
+        }
+    }
+
+    /* Taking every other name out, including one of the pair with the same hash, must leave the rest where they were. */
+    for (iName = 0; iName < nameCount; iName += 2) {
+        if (ma_resource_manager_unregister_data(&resourceManager, names[iName]) != MA_SUCCESS) {
+            pErrorMessage = "Failed to unregister data.";
+            goto done;
+        }
+    }
+
+    for (iName = 0; iName < nameCount; iName += 1) {
+        ma_resource_manager_data_buffer dataBuffer;
+
+        if ((iName & 1) == 0) {
+            if (ma_resource_manager_data_buffer_init(&resourceManager, names[iName], 0, NULL, &dataBuffer) == MA_SUCCESS) {
+                ma_resource_manager_data_buffer_uninit(&dataBuffer);
+                pErrorMessage = "An unregistered name was still found.";
+                goto done;
+            }
+        } else {
+            if (!test_hash_table__is_named(&resourceManager, names[iName], values[iName])) {
+                pErrorMessage = "Unregistering a name lost or changed another one.";
+                goto done;
+            }
+        }
+    }
+
+    if (pShard->nodeCount != nameCount / 2) {
+        pErrorMessage = "The shard's node count is wrong after unregistering.";
+        goto done;
+    }
+
+done:
+    for (iName = 1; iName < registeredCount; iName += 2) {
+        ma_resource_manager_unregister_data(&resourceManager, names[iName]);
+    }
+
+    if (pErrorMessage == NULL && test_hash_table__get_node_count(&resourceManager) != 0) {
+        pErrorMessage = "Nodes were left behind after unregistering everything.";
+    }
+
+    ma_resource_manager_uninit(&resourceManager);
+
+    return test_resource_manager__report(pErrorMessage);
+}
+
+
+typedef struct
+{
+    ma_resource_manager* pResourceManager;
+    const float* pSharedValues;
+    ma_uint32 threadIndex;
+    ma_bool32 isCorrect;
+} test_hash_table_thread;
+
+static void test_hash_table__get_shared_name(ma_uint32 index, char* pName)
+{
+    sprintf(pName, "shared_%u", index);
+}
+
+static ma_thread_result MA_THREADCALL test_hash_table__thread(void* pUserData)
+{
+    test_hash_table_thread* pThread = (test_hash_table_thread*)pUserData;
+    ma_lcg lcg;
+    char name[HASH_TABLE_TEST_MAX_NAME_LENGTH];
+    char ownName[HASH_TABLE_TEST_MAX_NAME_LENGTH];
+    float ownValue;
+    ma_uint32 iIteration;
+
+    pThread->isCorrect = MA_TRUE;
+    ma_lcg_seed(&lcg, (ma_int32)(pThread->threadIndex + 1));
+
+    for (iIteration = 0; iIteration < HASH_TABLE_TEST_ITERATION_COUNT && pThread->isCorrect; iIteration += 1) {
+        ma_resource_manager_data_buffer heldBuffer;
+        ma_uint32 sharedIndex;
+        ma_uint32 heldIndex;
+
+        /* Hold one shared name while acquiring and releasing another so references on different shards overlap. */
+        heldIndex = test_resource_manager__random_range(&lcg, 0, HASH_TABLE_TEST_SHARED_NAME_COUNT - 1);
+        test_hash_table__get_shared_name(heldIndex, name);
+        if (ma_resource_manager_data_buffer_init(pThread->pResourceManager, name, 0, NULL, &heldBuffer) != MA_SUCCESS) {
+            pThread->isCorrect = MA_FALSE;
+            break;
+        }
+
+        sharedIndex = test_resource_manager__random_range(&lcg, 0, HASH_TABLE_TEST_SHARED_NAME_COUNT - 1);
+        test_hash_table__get_shared_name(sharedIndex, name);
+        if (!test_hash_table__is_named(pThread->pResourceManager, name, pThread->pSharedValues[sharedIndex])) {
+            pThread->isCorrect = MA_FALSE;
+        }
+
+        ma_resource_manager_data_buffer_uninit(&heldBuffer);
+
+        /* A name only this thread knows about, inserted and removed while the other threads are doing the same to the same shards. */
+        sprintf(ownName, "thread_%u_%u", pThread->threadIndex, iIteration);
+        ownValue = -(float)(iIteration + 1);
+
+        if (ma_resource_manager_register_decoded_data(pThread->pResourceManager, ownName, &ownValue, 1, ma_format_f32, 1, 48000) != MA_SUCCESS) {
+            pThread->isCorrect = MA_FALSE;
+            break;
+        }
+
+        if (!test_hash_table__is_named(pThread->pResourceManager, ownName, ownValue)) {
+            pThread->isCorrect = MA_FALSE;
+        }
+
+        if (ma_resource_manager_unregister_data(pThread->pResourceManager, ownName) != MA_SUCCESS) {
+            pThread->isCorrect = MA_FALSE;
+        }
+    }
+
+    return (ma_thread_result)0;
+}
+
+static ma_result test_hash_table__concurrent(void)
+{
+    ma_result result;
+    ma_resource_manager_config resourceManagerConfig;
+    ma_resource_manager resourceManager;
+    test_hash_table_thread threadData[HASH_TABLE_TEST_THREAD_COUNT];
+    ma_thread threads[HASH_TABLE_TEST_THREAD_COUNT];
+    float sharedValues[HASH_TABLE_TEST_SHARED_NAME_COUNT];
+    char name[HASH_TABLE_TEST_MAX_NAME_LENGTH];
+    ma_uint32 usedShardCount = 0;
+    ma_uint32 registeredCount;
+    ma_uint32 iThread;
+    ma_uint32 iShard;
+    const char* pErrorMessage = NULL;
+
+    resourceManagerConfig = test_resource_manager__config_init(1);
+
+    result = ma_resource_manager_init(&resourceManagerConfig, &resourceManager);
+    if (result != MA_SUCCESS) {
+        printf("    Failed to initialize the resource manager.\n");
+        return result;
+    }
+
+    for (registeredCount = 0; registeredCount < HASH_TABLE_TEST_SHARED_NAME_COUNT; registeredCount += 1) {
+        sharedValues[registeredCount] = (float)(registeredCount + 1);
+        test_hash_table__get_shared_name(registeredCount, name);
+
+        if (ma_resource_manager_register_decoded_data(&resourceManager, name, &sharedValues[registeredCount], 1, ma_format_f32, 1, 48000) != MA_SUCCESS) {
+            pErrorMessage = "Failed to register data.";
+            goto done;
+        }
+    }
+
+    for (iShard = 0; iShard < ma_countof(resourceManager.dataBufferShards); iShard += 1) {
+        if (resourceManager.dataBufferShards[iShard].nodeCount > 0) {
+            usedShardCount += 1;
+        }
+    }
+
+    if (usedShardCount < 2) {
+        pErrorMessage = "The names were not spread across shards.";
+        goto done;
+    }
+
+    for (iThread = 0; iThread < HASH_TABLE_TEST_THREAD_COUNT; iThread += 1) {
+        threadData[iThread].pResourceManager = &resourceManager;
+        threadData[iThread].pSharedValues    = sharedValues;
+        threadData[iThread].threadIndex      = iThread;
+        threadData[iThread].isCorrect        = MA_FALSE;
+
+        ma_thread_create(&threads[iThread], ma_thread_priority_default, 0, test_hash_table__thread, &threadData[iThread], NULL);
+    }
+
+    for (iThread = 0; iThread < HASH_TABLE_TEST_THREAD_COUNT; iThread += 1) {
+        ma_thread_wait(&threads[iThread]);
+        if (!threadData[iThread].isCorrect) {
+            pErrorMessage = "A thread got back the wrong data.";
+        }
+    }
+
+    if (pErrorMessage == NULL && test_hash_table__get_node_count(&resourceManager) != HASH_TABLE_TEST_SHARED_NAME_COUNT) {
+        pErrorMessage = "The node count is wrong after every thread has finished.";
+    }
+
+done:
+    while (registeredCount > 0) {
+        registeredCount -= 1;
+        test_hash_table__get_shared_name(registeredCount, name);
+        ma_resource_manager_unregister_data(&resourceManager, name);
+    }
+
+    if (pErrorMessage == NULL && test_hash_table__get_node_count(&resourceManager) != 0) {
+        pErrorMessage = "Nodes were left behind after unregistering everything.";
+    }
+
+    ma_resource_manager_uninit(&resourceManager);
+
+    return test_resource_manager__report(pErrorMessage);
+}
+
+int test_entry__resource_manager_hash_table(int argc, char** argv)
+{
+    ma_bool32 hasError = MA_FALSE;
+
+    (void)argc;
+    (void)argv;
+
+    if (test_hash_table__collisions() != MA_SUCCESS) {
+        hasError = MA_TRUE;
+    }
+
+    printf("    %u threads acquiring and releasing across shards\n", HASH_TABLE_TEST_THREAD_COUNT);
+    if (test_hash_table__concurrent() != MA_SUCCESS) {
+        hasError = MA_TRUE;
+    }
+
+    if (hasError) {
+        return -1;
+    }
+
+    return 0;
+}
@@ -0,0 +1,219 @@
+/*
+Encoded data registered with ma_resource_manager_register_encoded_data_in_place() is registered as decoded data pointing straight at the
+frames in the application's buffer when it's a PCM WAV file that's already in the decoded format. Anything else is registered as encoded
+data like ma_resource_manager_register_encoded_data(), which never reads in place. Either way, what's read back has to be exactly what
+decoding the file gives.
+*/
+#define IN_PLACE_TEST_DIRECTORY     TEST_OUTPUT_DIR"/in_place"
+#define IN_PLACE_TEST_F32_WAV_PATH  IN_PLACE_TEST_DIRECTORY"/f32.wav"
+#define IN_PLACE_TEST_S16_WAV_PATH  IN_PLACE_TEST_DIRECTORY"/s16.wav"
+#define IN_PLACE_TEST_MP3_PATH      IN_PLACE_TEST_DIRECTORY"/test.mp3"
+#define IN_PLACE_TEST_NAME          "in_place_data"
+#define IN_PLACE_TEST_NAME_W        L"in_place_data"
+
+typedef enum
+{
+    test_in_place_register_encoded,
+    test_in_place_register_in_place,
+    test_in_place_register_in_place_w
+} test_in_place_register;
+
+/*
+Registers a file's content with the given function and checks whether it ended up being read in place. misalignment shifts the data by
+that many bytes in the application's buffer.
+*/
+static ma_result test_in_place__check(const char* pFilePath, test_in_place_register registerType, ma_format decodedFormat, ma_uint32 decodedChannels, ma_uint32 decodedSampleRate, size_t misalignment, ma_bool32 expectInPlace)
+{
+    ma_result result;
+    ma_resource_manager_config resourceManagerConfig;
+    ma_resource_manager resourceManager;
+    ma_resource_manager_data_source dataSource;
+    ma_resource_manager_data_buffer_node* pNode;
+    ma_resource_manager_stats stats;
+    void* pFileData;
+    size_t fileSizeInBytes;
+    ma_uint8* pBuffer = NULL;
+    const ma_uint8* pData;
+    float* pExpectedFrames = NULL;
+    float* pFrames = NULL;
+    ma_uint64 expectedLength;
+    ma_uint64 framesRead;
+    ma_uint32 channels;
+    ma_bool32 isInPlace;
+    const char* pErrorMessage = NULL;
+
+    if (ma_vfs_open_and_read_file(NULL, pFilePath, &pFileData, &fileSizeInBytes, NULL) != MA_SUCCESS) {
+        printf("    Failed to read %s.\n", pFilePath);
+        return MA_ERROR;
+    }
+
+    /* The copy the application registers. The extra room is for shifting it out of alignment. */
+    pBuffer = (ma_uint8*)ma_malloc(fileSizeInBytes + 4, NULL);
+    if (pBuffer == NULL) {
+        ma_free(pFileData, NULL);
+        return MA_OUT_OF_MEMORY;
+    }
+
+    pData = pBuffer + misalignment;
+    MA_COPY_MEMORY((void*)pData, pFileData, fileSizeInBytes);
+    ma_free(pFileData, NULL);
+
+    /*
+    The reference is decoded to f32 in the file's own channel count, so that's what the frames are compared as. Anything else is only
+    checked for where its frames come from.
+    */
+    if (decodedFormat == ma_format_f32 && decodedChannels == 0) {
+        result = test_resource_manager__decode_file(pFilePath, decodedSampleRate, &pExpectedFrames, &expectedLength, &channels);
+        if (result != MA_SUCCESS) {
+            printf("    Failed to decode the reference.\n");
+            ma_free(pBuffer, NULL);
+            return result;
+        }
+    }
+
+    resourceManagerConfig = test_resource_manager__config_init(0);
+    resourceManagerConfig.decodedFormat     = decodedFormat;
+    resourceManagerConfig.decodedChannels   = decodedChannels;
+    resourceManagerConfig.decodedSampleRate = decodedSampleRate;
+
+    result = ma_resource_manager_init(&resourceManagerConfig, &resourceManager);
+    if (result != MA_SUCCESS) {
+        printf("    Failed to initialize the resource manager.\n");
+        ma_free(pExpectedFrames, NULL);
+        ma_free(pBuffer, NULL);
+        return result;
+    }
+
+    if (registerType == test_in_place_register_encoded) {
+        result = ma_resource_manager_register_encoded_data(&resourceManager, IN_PLACE_TEST_NAME, pData, fileSizeInBytes);
+    } else if (registerType == test_in_place_register_in_place) {
+        result = ma_resource_manager_register_encoded_data_in_place(&resourceManager, IN_PLACE_TEST_NAME, pData, fileSizeInBytes);
+    } else {
+        result = ma_resource_manager_register_encoded_data_in_place_w(&resourceManager, IN_PLACE_TEST_NAME_W, pData, fileSizeInBytes);
+    }
+
+    if (result != MA_SUCCESS) {
+        printf("    Failed to register the data.\n");
+        ma_resource_manager_uninit(&resourceManager);
+        ma_free(pExpectedFrames, NULL);
+        ma_free(pBuffer, NULL);
+        return result;
+    }
+
+    if (registerType == test_in_place_register_in_place_w) {
+        result = ma_resource_manager_data_source_init_w(&resourceManager, IN_PLACE_TEST_NAME_W, MA_RESOURCE_MANAGER_DATA_SOURCE_FLAG_DECODE, NULL, &dataSource);
+    } else {
+        result = ma_resource_manager_data_source_init(&resourceManager, IN_PLACE_TEST_NAME, MA_RESOURCE_MANAGER_DATA_SOURCE_FLAG_DECODE, NULL, &dataSource);
+    }
+
+    if (result != MA_SUCCESS) {
+        pErrorMessage = "Failed to load the registered data.";
+        goto unregister;
+    }
+
+    /* In place means the node is decoded data pointing at the frames inside the application's buffer, so nothing was decoded or copied. */
+    pNode = dataSource.backend.buffer.pNode;
+    isInPlace = ma_resource_manager_data_buffer_node_get_data_supply_type(pNode) == ma_resource_manager_data_supply_type_decoded &&
+                (const ma_uint8*)pNode->data.backend.decoded.pData >  pData &&
+                (const ma_uint8*)pNode->data.backend.decoded.pData <  pData + fileSizeInBytes;
+
+    if (isInPlace != expectInPlace) {
+        pErrorMessage = expectInPlace ? "The data was not read in place." : "The data was read in place when it shouldn't have been.";
+        goto done;
+    }
+
+    if (isInPlace == MA_FALSE && ma_resource_manager_data_buffer_node_get_data_supply_type(pNode) != ma_resource_manager_data_supply_type_encoded) {
+        pErrorMessage = "Data that isn't read in place was not registered as encoded data.";
+        goto done;
+    }
+
+    ma_resource_manager_get_stats(&resourceManager, &stats);
+    if (isInPlace && stats.decodedBytes != 0) {
+        pErrorMessage = "Data read in place went through a decoder.";
+        goto done;
+    }
+
+    if (pExpectedFrames != NULL) {
+        pFrames = (float*)ma_malloc((size_t)(expectedLength * channels * sizeof(float)), NULL);
+        if (pFrames == NULL) {
+            pErrorMessage = "Out of memory.";
+            goto done;
+        }
+
+        framesRead = test_resource_manager__read_all(&dataSource, pFrames, channels, expectedLength);
+        if (framesRead != expectedLength || memcmp(pFrames, pExpectedFrames, (size_t)(framesRead * channels * sizeof(float))) != 0) {
+            pErrorMessage = "The registered data read differently to a normal decode.";
+            goto done;
+        }
+    }
+
+done:
+    ma_resource_manager_data_source_uninit(&dataSource);
+
+unregister:
+    if (registerType == test_in_place_register_in_place_w) {
+        ma_resource_manager_unregister_data_w(&resourceManager, IN_PLACE_TEST_NAME_W);
+    } else {
+        ma_resource_manager_unregister_data(&resourceManager, IN_PLACE_TEST_NAME);
+    }
+
+    ma_resource_manager_uninit(&resourceManager);
+    ma_free(pFrames, NULL);
+    ma_free(pExpectedFrames, NULL);
+    ma_free(pBuffer, NULL);
+
+    return test_resource_manager__report(pErrorMessage);
+}
+
+int test_entry__resource_manager_in_place(int argc, char** argv)
+{
+    ma_bool32 hasError = MA_FALSE;
+
+    (void)argc;
+    (void)argv;
+
+    if (test_resource_manager__create_directory(IN_PLACE_TEST_DIRECTORY) != MA_SUCCESS ||
+        test_resource_manager__write_wav(IN_PLACE_TEST_F32_WAV_PATH, ma_format_f32, 2, 44100, 10000) != MA_SUCCESS ||
+        test_resource_manager__write_wav(IN_PLACE_TEST_S16_WAV_PATH, ma_format_s16, 2, 44100, 10000) != MA_SUCCESS ||
+        test_resource_manager__write_mp3(IN_PLACE_TEST_MP3_PATH, 100) != MA_SUCCESS) {
+        printf("    Failed to generate test files.\n");
+        return -1;
+    }
+
+    printf("    Matching PCM WAV\n");
+    if (test_in_place__check(IN_PLACE_TEST_F32_WAV_PATH, test_in_place_register_in_place,   ma_format_f32, 0, 0, 0, MA_TRUE) != MA_SUCCESS ||
+        test_in_place__check(IN_PLACE_TEST_F32_WAV_PATH, test_in_place_register_in_place_w, ma_format_f32, 0, 0, 0, MA_TRUE) != MA_SUCCESS ||
+        test_in_place__check(IN_PLACE_TEST_F32_WAV_PATH, test_in_place_register_in_place,   ma_format_f32, 2, 44100, 0, MA_TRUE) != MA_SUCCESS ||
+        test_in_place__check(IN_PLACE_TEST_S16_WAV_PATH, test_in_place_register_in_place,   ma_format_s16, 0, 0, 0, MA_TRUE) != MA_SUCCESS) {
+        hasError = MA_TRUE;
+    }
+
+    printf("    Format, channel count or sample rate that doesn't match\n");
+    if (test_in_place__check(IN_PLACE_TEST_S16_WAV_PATH, test_in_place_register_in_place,   ma_format_f32, 0, 0, 0, MA_FALSE) != MA_SUCCESS ||
+        test_in_place__check(IN_PLACE_TEST_F32_WAV_PATH, test_in_place_register_in_place_w, ma_format_f32, 1, 0, 0, MA_FALSE) != MA_SUCCESS ||
+        test_in_place__check(IN_PLACE_TEST_F32_WAV_PATH, test_in_place_register_in_place,   ma_format_f32, 0, 48000, 0, MA_FALSE) != MA_SUCCESS) {
+        hasError = MA_TRUE;
+    }
+
+    printf("    Frames that aren't aligned for their sample type\n");
+    if (test_in_place__check(IN_PLACE_TEST_F32_WAV_PATH, test_in_place_register_in_place, ma_format_f32, 0, 0, 1, MA_FALSE) != MA_SUCCESS) {
+        hasError = MA_TRUE;
+    }
+
+    printf("    Something other than a WAV file\n");
+    if (test_in_place__check(IN_PLACE_TEST_MP3_PATH, test_in_place_register_in_place, ma_format_f32, 0, 0, 0, MA_FALSE) != MA_SUCCESS) {
+        hasError = MA_TRUE;
+    }
+
+    printf("    ma_resource_manager_register_encoded_data()\n");
+    if (test_in_place__check(IN_PLACE_TEST_F32_WAV_PATH, test_in_place_register_encoded, ma_format_f32, 0, 0, 0, MA_FALSE) != MA_SUCCESS ||
+        test_in_place__check(IN_PLACE_TEST_S16_WAV_PATH, test_in_place_register_encoded, ma_format_s16, 0, 0, 0, MA_FALSE) != MA_SUCCESS) {
+        hasError = MA_TRUE;
+    }
+
+    if (hasError) {
+        return -1;
+    }
+
+    return 0;
+}
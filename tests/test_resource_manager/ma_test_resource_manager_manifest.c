@@ -0,0 +1,203 @@
+/*
+The manifest has the first file in it twice and includes a big file that a sound is already loading, so the fence has to wait on loads
+the manifest didn't start itself.
+*/
+#define MANIFEST_TEST_DIRECTORY     TEST_OUTPUT_DIR"/manifest"
+#define MANIFEST_TEST_FILE_COUNT    5
+#define MANIFEST_TEST_BIG_PATH      MANIFEST_TEST_DIRECTORY"/big.wav"
+#define MANIFEST_TEST_ITERATIONS    20
+
+static char g_test_manifest_paths[MANIFEST_TEST_FILE_COUNT][64];
+
+static ma_result test_manifest__check_loaded(ma_resource_manager* pResourceManager, const char* pFilePath)
+{
+    ma_result result;
+    ma_resource_manager_data_source dataSource;
+    float* pExpectedFrames;
+    float* pFrames;
+    ma_uint64 expectedFrameCount;
+    ma_uint64 framesRead;
+    ma_uint32 channels;
+
+    result = test_resource_manager__decode_file(pFilePath, 0, &pExpectedFrames, &expectedFrameCount, &channels);
+    if (result != MA_SUCCESS) {
+        return result;
+    }
+
+    /* The file should already be fully decoded so an asynchronous load is finished straight away. */
+    result = ma_resource_manager_data_source_init(pResourceManager, pFilePath, MA_RESOURCE_MANAGER_DATA_SOURCE_FLAG_DECODE | MA_RESOURCE_MANAGER_DATA_SOURCE_FLAG_ASYNC, NULL, &dataSource);
+    if (result != MA_SUCCESS) {
+        ma_free(pExpectedFrames, NULL);
+        return result;
+    }
+
+    if (ma_resource_manager_data_source_result(&dataSource) != MA_SUCCESS) {
+        printf("    \"%s\" was not loaded when the fence was released.\n", pFilePath);
+        result = MA_ERROR;
+    } else {
+        pFrames = (float*)ma_malloc((size_t)(expectedFrameCount * channels * sizeof(float)), NULL);
+        if (pFrames == NULL) {
+            result = MA_OUT_OF_MEMORY;
+        } else {
+            framesRead = test_resource_manager__read_all(&dataSource, pFrames, channels, expectedFrameCount);
+            if (framesRead != expectedFrameCount || memcmp(pFrames, pExpectedFrames, (size_t)(framesRead * channels * sizeof(float))) != 0) {
+                printf("    \"%s\" was not loaded correctly.\n", pFilePath);
+                result = MA_ERROR;
+            }
+
+            ma_free(pFrames, NULL);
+        }
+    }
+
+    ma_resource_manager_data_source_uninit(&dataSource);
+    ma_free(pExpectedFrames, NULL);
+
+    return result;
+}
+
+static ma_result test_manifest__run(ma_uint32 jobThreadCount)
+{
+    ma_result result = MA_SUCCESS;
+    ma_resource_manager_config resourceManagerConfig;
+    ma_resource_manager resourceManager;
+    ma_resource_manager_manifest_entry manifest[MANIFEST_TEST_FILE_COUNT + 3];
+    ma_resource_manager_data_source bigDataSource;
+    ma_fence fence;
+    ma_uint64 baselineMemoryUsage;
+    ma_uint32 manifestCount = 0;
+    ma_uint32 iteration;
+    ma_uint32 iFile;
+
+    printf("    %u job threads\n", jobThreadCount);
+
+    resourceManagerConfig = test_resource_manager__config_init(jobThreadCount);
+    result = ma_resource_manager_init(&resourceManagerConfig, &resourceManager);
+    if (result != MA_SUCCESS) {
+        return result;
+    }
+
+    baselineMemoryUsage = ma_resource_manager_get_memory_usage_in_bytes(&resourceManager);
+
+    /* The big file is in the middle and the first file is in there twice. */
+    for (iFile = 0; iFile < MANIFEST_TEST_FILE_COUNT; iFile += 1) {
+        if (iFile == 1) {
+            manifest[manifestCount].pFilePath  = MANIFEST_TEST_BIG_PATH;
+            manifest[manifestCount].pFilePathW = NULL;
+            manifest[manifestCount].flags      = MA_RESOURCE_MANAGER_DATA_SOURCE_FLAG_DECODE;
+            manifestCount += 1;
+        }
+
+        if (iFile == 3) {
+            manifest[manifestCount] = manifest[0];
+            manifestCount += 1;
+        }
+
+        manifest[manifestCount].pFilePath  = g_test_manifest_paths[iFile];
+        manifest[manifestCount].pFilePathW = NULL;
+        manifest[manifestCount].flags      = MA_RESOURCE_MANAGER_DATA_SOURCE_FLAG_DECODE;
+        manifestCount += 1;
+    }
+
+    for (iteration = 0; iteration < MANIFEST_TEST_ITERATIONS && result == MA_SUCCESS; iteration += 1) {
+        ma_fence_init(&fence);
+
+        /* Somebody else is already loading the big file. The manifest needs to wait for it rather than load it again. */
+        result = ma_resource_manager_data_source_init(&resourceManager, MANIFEST_TEST_BIG_PATH, MA_RESOURCE_MANAGER_DATA_SOURCE_FLAG_DECODE | MA_RESOURCE_MANAGER_DATA_SOURCE_FLAG_ASYNC, NULL, &bigDataSource);
+        if (result != MA_SUCCESS) {
+            ma_fence_uninit(&fence);
+            break;
+        }
+
+        result = ma_resource_manager_register_manifest(&resourceManager, manifest, manifestCount, &fence);
+        ma_fence_wait(&fence);
+
+        if (result != MA_SUCCESS) {
+            printf("    Failed to register the manifest: %s.\n", ma_result_description(result));
+        } else {
+            for (iFile = 0; iFile < MANIFEST_TEST_FILE_COUNT; iFile += 1) {
+                if (test_manifest__check_loaded(&resourceManager, g_test_manifest_paths[iFile]) != MA_SUCCESS) {
+                    result = MA_ERROR;
+                }
+            }
+
+            if (test_manifest__check_loaded(&resourceManager, MANIFEST_TEST_BIG_PATH) != MA_SUCCESS) {
+                result = MA_ERROR;
+            }
+
+            ma_resource_manager_unregister_manifest(&resourceManager, manifest, manifestCount);
+        }
+
+        ma_resource_manager_data_source_uninit(&bigDataSource);
+        ma_fence_uninit(&fence);
+
+        if (!test_resource_manager__wait_for_memory_usage(&resourceManager, baselineMemoryUsage)) {
+            printf("    Unregistering the manifest did not free everything.\n");
+            result = MA_ERROR;
+        }
+    }
+
+    /* A missing file fails the load, but the fence must still be released and nothing may be left behind. */
+    if (result == MA_SUCCESS) {
+        manifest[manifestCount].pFilePath  = MANIFEST_TEST_DIRECTORY"/missing.wav";
+        manifest[manifestCount].pFilePathW = NULL;
+        manifest[manifestCount].flags      = MA_RESOURCE_MANAGER_DATA_SOURCE_FLAG_DECODE;
+
+        ma_fence_init(&fence);
+        if (ma_resource_manager_register_manifest(&resourceManager, manifest, manifestCount + 1, &fence) == MA_SUCCESS) {
+            ma_fence_wait(&fence);
+            ma_resource_manager_unregister_manifest(&resourceManager, manifest, manifestCount + 1);
+        } else {
+            ma_fence_wait(&fence);
+        }
+        ma_fence_uninit(&fence);
+
+        if (!test_resource_manager__wait_for_memory_usage(&resourceManager, baselineMemoryUsage)) {
+            printf("    A failed manifest left data behind.\n");
+            result = MA_ERROR;
+        }
+    }
+
+    ma_resource_manager_uninit(&resourceManager);
+
+    return result;
+}
+
+int test_entry__resource_manager_manifest(int argc, char** argv)
+{
+    ma_bool32 hasError = MA_FALSE;
+    ma_uint32 iFile;
+
+    (void)argc;
+    (void)argv;
+
+    if (test_resource_manager__create_directory(MANIFEST_TEST_DIRECTORY) != MA_SUCCESS) {
+        return -1;
+    }
+
+    for (iFile = 0; iFile < MANIFEST_TEST_FILE_COUNT; iFile += 1) {
+        sprintf(g_test_manifest_paths[iFile], "%s/%u.wav", MANIFEST_TEST_DIRECTORY, iFile);
+        if (test_resource_manager__write_wav(g_test_manifest_paths[iFile], ma_format_s16, 2, 44100, 1000 + iFile*3000) != MA_SUCCESS) {
+            printf("    Failed to generate test files.\n");
+            return -1;
+        }
+    }
+
+    if (test_resource_manager__write_wav(MANIFEST_TEST_BIG_PATH, ma_format_s16, 2, 44100, 44100*10) != MA_SUCCESS) {
+        printf("    Failed to generate test files.\n");
+        return -1;
+    }
+
+    if (test_manifest__run(2) != MA_SUCCESS) {
+        hasError = MA_TRUE;
+    }
+
+    if (test_manifest__run(0) != MA_SUCCESS) {
+        hasError = MA_TRUE;
+    }
+
+    if (hasError) {
+        return -1;
+    }
+
+    return 0;
+}
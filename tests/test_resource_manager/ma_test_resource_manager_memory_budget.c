@@ -0,0 +1,282 @@
+/*
+Unreferenced data buffers stay resident until the memory budget is exceeded, at which point the least recently used are unloaded first.
+Pinned files are never unloaded. Whether a file was still resident is told apart by whether loading it decoded anything.
+*/
+#define MEMORY_BUDGET_TEST_DIRECTORY    TEST_OUTPUT_DIR"/memory_budget"
+#define MEMORY_BUDGET_TEST_PATH_A       MEMORY_BUDGET_TEST_DIRECTORY"/a.wav"
+#define MEMORY_BUDGET_TEST_PATH_B       MEMORY_BUDGET_TEST_DIRECTORY"/b.wav"
+#define MEMORY_BUDGET_TEST_PATH_C       MEMORY_BUDGET_TEST_DIRECTORY"/c.wav"
+#define MEMORY_BUDGET_TEST_FRAME_COUNT  10000
+#define MEMORY_BUDGET_TEST_SIZE         (MEMORY_BUDGET_TEST_FRAME_COUNT * sizeof(float))   /* Each file is mono and decoded to f32. */
+
+/* Loads a file and releases it straight away. Sets *pWasResident to whether it was still loaded from before. */
+static ma_result test_memory_budget__load(ma_resource_manager* pResourceManager, const char* pFilePath, ma_bool32* pWasResident)
+{
+    ma_result result;
+    ma_resource_manager_data_source dataSource;
+    ma_resource_manager_stats stats;
+    ma_uint64 decodedBytes;
+
+    ma_resource_manager_get_stats(pResourceManager, &stats);
+    decodedBytes = stats.decodedBytes;
+
+    result = ma_resource_manager_data_source_init(pResourceManager, pFilePath, MA_RESOURCE_MANAGER_DATA_SOURCE_FLAG_DECODE, NULL, &dataSource);
+    if (result != MA_SUCCESS) {
+        return result;
+    }
+
+    ma_resource_manager_data_source_uninit(&dataSource);
+
+    ma_resource_manager_get_stats(pResourceManager, &stats);
+    *pWasResident = (stats.decodedBytes == decodedBytes);
+
+    return MA_SUCCESS;
+}
+
+/* Loads a file and checks whether it was resident, which also makes it the most recently used. */
+static ma_bool32 test_memory_budget__check_load(ma_resource_manager* pResourceManager, const char* pFilePath, ma_bool32 expectResident)
+{
+    ma_bool32 wasResident;
+
+    if (test_memory_budget__load(pResourceManager, pFilePath, &wasResident) != MA_SUCCESS) {
+        return MA_FALSE;
+    }
+
+    return wasResident == expectResident;
+}
+
+static ma_result test_memory_budget__eviction(void)
+{
+    ma_result result;
+    ma_resource_manager_config resourceManagerConfig;
+    ma_resource_manager resourceManager;
+    ma_resource_manager_data_source dataSources[3];
+    ma_uint64 baselineMemoryUsage;
+    ma_uint32 iDataSource;
+    const char* pErrorMessage = NULL;
+
+    printf("    Eviction\n");
+
+    /* Room for two of the files, but not three. */
+    resourceManagerConfig = test_resource_manager__config_init(0);
+    resourceManagerConfig.memoryBudgetInBytes = MEMORY_BUDGET_TEST_SIZE*2 + MEMORY_BUDGET_TEST_SIZE/2;
+
+    result = ma_resource_manager_init(&resourceManagerConfig, &resourceManager);
+    if (result != MA_SUCCESS) {
+        return result;
+    }
+
+    baselineMemoryUsage = ma_resource_manager_get_memory_usage_in_bytes(&resourceManager);
+
+    /* Nothing is unloaded while within the budget. */
+    if (!test_memory_budget__check_load(&resourceManager, MEMORY_BUDGET_TEST_PATH_A, MA_FALSE) ||
+        !test_memory_budget__check_load(&resourceManager, MEMORY_BUDGET_TEST_PATH_B, MA_FALSE) ||
+        !test_resource_manager__wait_for_memory_usage(&resourceManager, baselineMemoryUsage + MEMORY_BUDGET_TEST_SIZE*2)) {
+        pErrorMessage = "Unreferenced files were not kept resident.";
+        goto done;
+    }
+
+    /* Using A again makes B the least recently used, so B is what makes room for C. */
+    if (!test_memory_budget__check_load(&resourceManager, MEMORY_BUDGET_TEST_PATH_A, MA_TRUE) ||
+        !test_memory_budget__check_load(&resourceManager, MEMORY_BUDGET_TEST_PATH_C, MA_FALSE) ||
+        !test_resource_manager__wait_for_memory_usage(&resourceManager, baselineMemoryUsage + MEMORY_BUDGET_TEST_SIZE*2)) {
+        pErrorMessage = "Going over the budget did not unload anything.";
+        goto done;
+    }
+
+    /* Checking A then C makes each of them most recently used in turn, so reloading B then evicts A. */
+    if (!test_memory_budget__check_load(&resourceManager, MEMORY_BUDGET_TEST_PATH_A, MA_TRUE) ||
+        !test_memory_budget__check_load(&resourceManager, MEMORY_BUDGET_TEST_PATH_C, MA_TRUE) ||
+        !test_memory_budget__check_load(&resourceManager, MEMORY_BUDGET_TEST_PATH_B, MA_FALSE) ||
+        !test_memory_budget__check_load(&resourceManager, MEMORY_BUDGET_TEST_PATH_C, MA_TRUE) ||
+        !test_memory_budget__check_load(&resourceManager, MEMORY_BUDGET_TEST_PATH_B, MA_TRUE) ||
+        !test_memory_budget__check_load(&resourceManager, MEMORY_BUDGET_TEST_PATH_A, MA_FALSE)) {
+        pErrorMessage = "Files were not unloaded in least recently used order.";
+        goto done;
+    }
+
+    /* Referenced files count towards the budget but are never unloaded to get back under it. */
+    for (iDataSource = 0; iDataSource < 3; iDataSource += 1) {
+        static const char* pFilePaths[3] = { MEMORY_BUDGET_TEST_PATH_A, MEMORY_BUDGET_TEST_PATH_B, MEMORY_BUDGET_TEST_PATH_C };
+
+        result = ma_resource_manager_data_source_init(&resourceManager, pFilePaths[iDataSource], MA_RESOURCE_MANAGER_DATA_SOURCE_FLAG_DECODE, NULL, &dataSources[iDataSource]);
+        if (result != MA_SUCCESS) {
+            while (iDataSource > 0) {
+                iDataSource -= 1;
+                ma_resource_manager_data_source_uninit(&dataSources[iDataSource]);
+            }
+
+            pErrorMessage = "Failed to load a file.";
+            goto done;
+        }
+    }
+
+    if (ma_resource_manager_get_memory_usage_in_bytes(&resourceManager) != baselineMemoryUsage + MEMORY_BUDGET_TEST_SIZE*3) {
+        pErrorMessage = "A referenced file was unloaded.";
+    }
+
+    for (iDataSource = 0; iDataSource < 3; iDataSource += 1) {
+        ma_resource_manager_data_source_uninit(&dataSources[iDataSource]);
+    }
+
+    if (pErrorMessage != NULL) {
+        goto done;
+    }
+
+    /* Once they're all released the oldest is unloaded to get back within the budget. */
+    if (!test_resource_manager__wait_for_memory_usage(&resourceManager, baselineMemoryUsage + MEMORY_BUDGET_TEST_SIZE*2)) {
+        pErrorMessage = "Memory usage did not come back within the budget.";
+        goto done;
+    }
+
+done:
+    ma_resource_manager_uninit(&resourceManager);
+
+    return test_resource_manager__report(pErrorMessage);
+}
+
+static ma_result test_memory_budget__pinning(ma_uint64 memoryBudgetInBytes)
+{
+    ma_result result;
+    ma_resource_manager_config resourceManagerConfig;
+    ma_resource_manager resourceManager;
+    ma_uint64 baselineMemoryUsage;
+    float* pFrames;
+    const char* pErrorMessage = NULL;
+
+    printf("    Pinning with a budget of %u bytes\n", (unsigned int)memoryBudgetInBytes);
+
+    resourceManagerConfig = test_resource_manager__config_init(0);
+    resourceManagerConfig.memoryBudgetInBytes = memoryBudgetInBytes;
+
+    result = ma_resource_manager_init(&resourceManagerConfig, &resourceManager);
+    if (result != MA_SUCCESS) {
+        return result;
+    }
+
+    baselineMemoryUsage = ma_resource_manager_get_memory_usage_in_bytes(&resourceManager);
+
+    pFrames = (float*)ma_malloc(MEMORY_BUDGET_TEST_SIZE, NULL);
+    if (pFrames == NULL) {
+        ma_resource_manager_uninit(&resourceManager);
+        return MA_OUT_OF_MEMORY;
+    }
+
+    MA_ZERO_MEMORY(pFrames, MEMORY_BUDGET_TEST_SIZE);
+
+    /* Only something that has been loaded can be pinned. */
+    if (ma_resource_manager_pin(&resourceManager, MEMORY_BUDGET_TEST_PATH_A) != MA_DOES_NOT_EXIST) {
+        pErrorMessage = "A file that isn't loaded was pinned.";
+        goto done;
+    }
+
+    /* The file has to be referenced while it's pinned or it would be unloaded before getting the chance when there's no budget. */
+    {
+        ma_resource_manager_data_source dataSource;
+
+        if (ma_resource_manager_data_source_init(&resourceManager, MEMORY_BUDGET_TEST_PATH_A, MA_RESOURCE_MANAGER_DATA_SOURCE_FLAG_DECODE, NULL, &dataSource) != MA_SUCCESS) {
+            pErrorMessage = "Failed to load a file.";
+            goto done;
+        }
+
+        result = ma_resource_manager_pin(&resourceManager, MEMORY_BUDGET_TEST_PATH_A);
+        ma_resource_manager_data_source_uninit(&dataSource);
+
+        if (result != MA_SUCCESS) {
+            pErrorMessage = "Failed to pin a file.";
+            goto done;
+        }
+    }
+
+    /* A is now the least recently used but being pinned it stays put while B and C take turns. */
+    if (!test_memory_budget__check_load(&resourceManager, MEMORY_BUDGET_TEST_PATH_B, MA_FALSE) ||
+        !test_memory_budget__check_load(&resourceManager, MEMORY_BUDGET_TEST_PATH_C, MA_FALSE) ||
+        !test_memory_budget__check_load(&resourceManager, MEMORY_BUDGET_TEST_PATH_A, MA_TRUE)) {
+        pErrorMessage = "A pinned file was unloaded.";
+        goto done;
+    }
+
+    /* Once unpinned it's treated like any other unreferenced file. Without a budget that means it's unloaded straight away. */
+    if (ma_resource_manager_unpin(&resourceManager, MEMORY_BUDGET_TEST_PATH_A) != MA_SUCCESS) {
+        pErrorMessage = "Failed to unpin a file.";
+        goto done;
+    }
+
+    if (memoryBudgetInBytes == 0) {
+        if (!test_resource_manager__wait_for_memory_usage(&resourceManager, baselineMemoryUsage) ||
+            !test_memory_budget__check_load(&resourceManager, MEMORY_BUDGET_TEST_PATH_A, MA_FALSE)) {
+            pErrorMessage = "An unpinned file was not unloaded.";
+            goto done;
+        }
+    } else {
+        /* It goes to the back of the queue, behind C, so it's what's unloaded next rather than C. */
+        if (!test_resource_manager__wait_for_memory_usage(&resourceManager, baselineMemoryUsage + MEMORY_BUDGET_TEST_SIZE*2) ||
+            !test_memory_budget__check_load(&resourceManager, MEMORY_BUDGET_TEST_PATH_C, MA_TRUE) ||
+            !test_memory_budget__check_load(&resourceManager, MEMORY_BUDGET_TEST_PATH_B, MA_FALSE) ||
+            !test_memory_budget__check_load(&resourceManager, MEMORY_BUDGET_TEST_PATH_C, MA_TRUE) ||
+            !test_memory_budget__check_load(&resourceManager, MEMORY_BUDGET_TEST_PATH_A, MA_FALSE)) {
+            pErrorMessage = "An unpinned file was not put back under the budget.";
+            goto done;
+        }
+    }
+
+    /* Registered data belongs to the application so it can't be kept around after it has been unregistered. */
+    if (ma_resource_manager_register_decoded_data(&resourceManager, "registered", pFrames, MEMORY_BUDGET_TEST_FRAME_COUNT, ma_format_f32, 1, 44100) != MA_SUCCESS) {
+        pErrorMessage = "Failed to register decoded data.";
+        goto done;
+    }
+
+    result = ma_resource_manager_pin(&resourceManager, "registered");
+    ma_resource_manager_unregister_data(&resourceManager, "registered");
+
+    if (result != MA_INVALID_OPERATION) {
+        pErrorMessage = "Registered data was pinned.";
+        goto done;
+    }
+
+    if (ma_resource_manager_pin(&resourceManager, "registered") != MA_DOES_NOT_EXIST) {
+        pErrorMessage = "Registered data is still there after being unregistered.";
+        goto done;
+    }
+
+done:
+    ma_resource_manager_uninit(&resourceManager);
+    ma_free(pFrames, NULL);
+
+    return test_resource_manager__report(pErrorMessage);
+}
+
+int test_entry__resource_manager_memory_budget(int argc, char** argv)
+{
+    ma_bool32 hasError = MA_FALSE;
+
+    (void)argc;
+    (void)argv;
+
+    if (test_resource_manager__create_directory(MEMORY_BUDGET_TEST_DIRECTORY) != MA_SUCCESS ||
+        test_resource_manager__write_wav(MEMORY_BUDGET_TEST_PATH_A, ma_format_s16, 1, 44100, MEMORY_BUDGET_TEST_FRAME_COUNT) != MA_SUCCESS ||
+        test_resource_manager__write_wav(MEMORY_BUDGET_TEST_PATH_B, ma_format_s16, 1, 44100, MEMORY_BUDGET_TEST_FRAME_COUNT) != MA_SUCCESS ||
+        test_resource_manager__write_wav(MEMORY_BUDGET_TEST_PATH_C, ma_format_s16, 1, 44100, MEMORY_BUDGET_TEST_FRAME_COUNT) != MA_SUCCESS) {
+        printf("    Failed to generate test files.\n");
+        return -1;
+    }
+
+    if (test_memory_budget__eviction() != MA_SUCCESS) {
+        hasError = MA_TRUE;
+    }
+
+    if (test_memory_budget__pinning(0) != MA_SUCCESS) {
+        hasError = MA_TRUE;
+    }
+
+    /* Room for the pinned file and one more, so B and C have to evict each other. */
+    if (test_memory_budget__pinning(MEMORY_BUDGET_TEST_SIZE*2 + MEMORY_BUDGET_TEST_SIZE/2) != MA_SUCCESS) {
+        hasError = MA_TRUE;
+    }
+
+    if (hasError) {
+        return -1;
+    }
+
+    return 0;
+}
@@ -0,0 +1,334 @@
+/*
+Files loaded through ma_mmap_vfs are read straight out of the mapping instead of being copied into a buffer of the resource manager's
+own, so they don't count towards its memory usage. What's read from them has to be exactly what's read from a normal load, and files
+that can't be mapped have to keep working through the fallback.
+*/
+#define MMAP_TEST_DIRECTORY         TEST_OUTPUT_DIR"/mmap"
+#define MMAP_TEST_WAV_PATH          MMAP_TEST_DIRECTORY"/test.wav"
+#define MMAP_TEST_F32_WAV_PATH      MMAP_TEST_DIRECTORY"/f32.wav"
+#define MMAP_TEST_MP3_PATH          MMAP_TEST_DIRECTORY"/test.mp3"
+#define MMAP_TEST_EMPTY_PATH        MMAP_TEST_DIRECTORY"/empty.bin"
+#define MMAP_TEST_WRITTEN_PATH      MMAP_TEST_DIRECTORY"/written.bin"
+
+typedef struct
+{
+    float* pFrames;
+    ma_uint64 frameCount;
+    ma_uint32 channels;
+    ma_uint64 memoryUsageInBytes;   /* How much the resource manager's memory usage went up by while the file was loaded. */
+    ma_bool32 isMapped;             /* Whether or not the node borrowed a mapped view of the file. */
+} test_mmap_load;
+
+static ma_result test_mmap__load(ma_vfs* pVFS, const char* pFilePath, ma_uint32 flags, test_mmap_load* pLoad)
+{
+    ma_result result;
+    ma_resource_manager_config resourceManagerConfig;
+    ma_resource_manager resourceManager;
+    ma_resource_manager_data_source dataSource;
+    ma_resource_manager_data_buffer_node* pNode;
+    ma_uint64 initialMemoryUsage;
+
+    MA_ZERO_OBJECT(pLoad);
+
+    resourceManagerConfig = test_resource_manager__config_init(0);
+    resourceManagerConfig.pVFS = pVFS;
+
+    result = ma_resource_manager_init(&resourceManagerConfig, &resourceManager);
+    if (result != MA_SUCCESS) {
+        printf("    Failed to initialize the resource manager.\n");
+        return result;
+    }
+
+    initialMemoryUsage = ma_resource_manager_get_memory_usage_in_bytes(&resourceManager);
+
+    result = ma_resource_manager_data_source_init(&resourceManager, pFilePath, flags, NULL, &dataSource);
+    if (result != MA_SUCCESS) {
+        ma_resource_manager_uninit(&resourceManager);
+        return result;
+    }
+
+    pLoad->memoryUsageInBytes = ma_resource_manager_get_memory_usage_in_bytes(&resourceManager) - initialMemoryUsage;
+
+    pNode = dataSource.backend.buffer.pNode;
+    if (ma_resource_manager_data_buffer_node_get_data_supply_type(pNode) == ma_resource_manager_data_supply_type_encoded) {
+        pLoad->isMapped = pNode->data.backend.encoded.file != NULL;
+    } else if (ma_resource_manager_data_buffer_node_get_data_supply_type(pNode) == ma_resource_manager_data_supply_type_decoded) {
+        pLoad->isMapped = pNode->data.backend.decoded.file != NULL;
+    }
+
+    ma_data_source_get_data_format(&dataSource, NULL, &pLoad->channels, NULL, NULL, 0);
+
+    result = ma_data_source_get_length_in_pcm_frames(&dataSource, &pLoad->frameCount);
+    if (result == MA_SUCCESS) {
+        pLoad->pFrames = (float*)ma_malloc((size_t)(pLoad->frameCount * pLoad->channels * sizeof(float)), NULL);
+        if (pLoad->pFrames == NULL) {
+            result = MA_OUT_OF_MEMORY;
+        } else {
+            pLoad->frameCount = test_resource_manager__read_all(&dataSource, pLoad->pFrames, pLoad->channels, pLoad->frameCount);
+        }
+    }
+
+    ma_resource_manager_data_source_uninit(&dataSource);
+
+    /* Everything, mapped or not, has to be given back once the file is unloaded. */
+    if (result == MA_SUCCESS && test_resource_manager__wait_for_memory_usage(&resourceManager, initialMemoryUsage) == MA_FALSE) {
+        printf("    Memory usage did not come back down after unloading.\n");
+        result = MA_ERROR;
+    }
+
+    ma_resource_manager_uninit(&resourceManager);
+
+    if (result != MA_SUCCESS) {
+        ma_free(pLoad->pFrames, NULL);
+        pLoad->pFrames = NULL;
+    }
+
+    return result;
+}
+
+/*
+Loads a file through the default VFS and then through pVFS and checks that both gave the same frames. expectedMemoryUsage is what the
+load through pVFS is expected to count towards memory usage.
+*/
+static ma_result test_mmap__check(ma_vfs* pVFS, const char* pFilePath, ma_uint32 flags, ma_bool32 expectMapped, ma_uint64 expectedMemoryUsage)
+{
+    ma_default_vfs defaultVFS;
+    test_mmap_load expected;
+    test_mmap_load actual;
+    const char* pErrorMessage = NULL;
+
+    MA_ZERO_OBJECT(&actual);
+
+    ma_default_vfs_init(&defaultVFS, NULL);
+
+    if (test_mmap__load((ma_vfs*)&defaultVFS, pFilePath, flags, &expected) != MA_SUCCESS) {
+        printf("    Failed to load the reference through the default VFS.\n");
+        return MA_ERROR;
+    }
+
+    if (expected.isMapped) {
+        pErrorMessage = "The default VFS was treated as being able to map files.";
+        goto done;
+    }
+
+    if (test_mmap__load(pVFS, pFilePath, flags, &actual) != MA_SUCCESS) {
+        pErrorMessage = "Failed to load the file.";
+        goto done;
+    }
+
+    if (actual.isMapped != expectMapped) {
+        pErrorMessage = expectMapped ? "The file was copied instead of being mapped." : "The file was mapped by a VFS that can't map.";
+        goto done;
+    }
+
+    if (actual.memoryUsageInBytes != expectedMemoryUsage) {
+        printf("    Expected %u bytes of memory usage, got %u.\n", (ma_uint32)expectedMemoryUsage, (ma_uint32)actual.memoryUsageInBytes);
+        pErrorMessage = "The load counted the wrong amount of memory.";
+        goto done;
+    }
+
+    if (actual.channels != expected.channels || actual.frameCount != expected.frameCount || actual.frameCount == 0 ||
+        memcmp(actual.pFrames, expected.pFrames, (size_t)(actual.frameCount * actual.channels * sizeof(float))) != 0) {
+        pErrorMessage = "The file read differently to a load through the default VFS.";
+        goto done;
+    }
+
+done:
+    ma_free(actual.pFrames, NULL);
+    ma_free(expected.pFrames, NULL);
+
+    return test_resource_manager__report(pErrorMessage);
+}
+
+/* Files that can't be mapped, or are opened for writing, are passed through to the default VFS. */
+static ma_result test_mmap__check_unmapped_files(ma_mmap_vfs* pMmapVFS)
+{
+    static const char data[] = "Written through ma_mmap_vfs.";
+    char readBack[sizeof(data)];
+    ma_vfs* pVFS = (ma_vfs*)pMmapVFS;
+    ma_vfs_file file;
+    const void* pMappedData;
+    size_t mappedSizeInBytes;
+    size_t bytesRead;
+    size_t bytesWritten;
+    ma_uint64 initialMemoryUsage;
+    ma_resource_manager_config resourceManagerConfig;
+    ma_resource_manager resourceManager;
+    ma_resource_manager_data_source dataSource;
+    ma_result result;
+    const char* pErrorMessage = NULL;
+
+    /* An empty file opens, but there's nothing to map and nothing to read. */
+    if (ma_vfs_open(pVFS, MMAP_TEST_EMPTY_PATH, MA_OPEN_MODE_READ, &file) != MA_SUCCESS) {
+        return test_resource_manager__report("Failed to open an empty file.");
+    }
+
+    if (ma_vfs_map(pVFS, file, &pMappedData, &mappedSizeInBytes) == MA_SUCCESS) {
+        pErrorMessage = "An empty file was mapped.";
+    } else if (ma_vfs_read(pVFS, file, readBack, sizeof(readBack), &bytesRead) != MA_AT_END || bytesRead != 0) {
+        pErrorMessage = "Reading an empty file did not report the end.";
+    }
+
+    ma_vfs_close(pVFS, file);
+
+    if (pErrorMessage != NULL) {
+        return test_resource_manager__report(pErrorMessage);
+    }
+
+    /* A file opened for writing isn't mapped. Once it's written and reopened for reading it is. */
+    if (ma_vfs_open(pVFS, MMAP_TEST_WRITTEN_PATH, MA_OPEN_MODE_WRITE, &file) != MA_SUCCESS) {
+        return test_resource_manager__report("Failed to open a file for writing.");
+    }
+
+    if (ma_vfs_map(pVFS, file, &pMappedData, &mappedSizeInBytes) == MA_SUCCESS) {
+        pErrorMessage = "A file opened for writing was mapped.";
+    } else if (ma_vfs_write(pVFS, file, data, sizeof(data), &bytesWritten) != MA_SUCCESS || bytesWritten != sizeof(data)) {
+        pErrorMessage = "Failed to write through ma_mmap_vfs.";
+    }
+
+    ma_vfs_close(pVFS, file);
+
+    if (pErrorMessage != NULL) {
+        return test_resource_manager__report(pErrorMessage);
+    }
+
+    if (ma_vfs_open(pVFS, MMAP_TEST_WRITTEN_PATH, MA_OPEN_MODE_READ, &file) != MA_SUCCESS) {
+        return test_resource_manager__report("Failed to reopen the written file.");
+    }
+
+    if (ma_vfs_map(pVFS, file, &pMappedData, &mappedSizeInBytes) != MA_SUCCESS || mappedSizeInBytes != sizeof(data) || memcmp(pMappedData, data, sizeof(data)) != 0) {
+        pErrorMessage = "The written file was not mapped with what was written to it.";
+    } else if (ma_vfs_read(pVFS, file, readBack, sizeof(readBack), &bytesRead) != MA_SUCCESS || bytesRead != sizeof(data) || memcmp(readBack, data, sizeof(data)) != 0) {
+        pErrorMessage = "Reading the written file gave something other than what was written to it.";
+    }
+
+    ma_vfs_close(pVFS, file);
+
+    if (pErrorMessage != NULL) {
+        return test_resource_manager__report(pErrorMessage);
+    }
+
+    /* The resource manager has to fail cleanly on a file it can neither map nor decode. */
+    resourceManagerConfig = test_resource_manager__config_init(0);
+    resourceManagerConfig.pVFS = pVFS;
+
+    if (ma_resource_manager_init(&resourceManagerConfig, &resourceManager) != MA_SUCCESS) {
+        return test_resource_manager__report("Failed to initialize the resource manager.");
+    }
+
+    initialMemoryUsage = ma_resource_manager_get_memory_usage_in_bytes(&resourceManager);
+
+    result = ma_resource_manager_data_source_init(&resourceManager, MMAP_TEST_EMPTY_PATH, 0, NULL, &dataSource);
+    if (result == MA_SUCCESS) {
+        ma_resource_manager_data_source_uninit(&dataSource);
+        pErrorMessage = "An empty file was loaded.";
+    } else if (ma_resource_manager_get_memory_usage_in_bytes(&resourceManager) != initialMemoryUsage) {
+        pErrorMessage = "A failed load changed memory usage.";
+    }
+
+    ma_resource_manager_uninit(&resourceManager);
+
+    return test_resource_manager__report(pErrorMessage);
+}
+
+static ma_uint64 test_mmap__get_file_size(const char* pFilePath)
+{
+    ma_default_vfs defaultVFS;
+    ma_vfs_file file;
+    ma_file_info info;
+
+    ma_default_vfs_init(&defaultVFS, NULL);
+
+    if (ma_vfs_open(&defaultVFS, pFilePath, MA_OPEN_MODE_READ, &file) != MA_SUCCESS) {
+        return 0;
+    }
+
+    if (ma_vfs_info(&defaultVFS, file, &info) != MA_SUCCESS) {
+        info.sizeInBytes = 0;
+    }
+
+    ma_vfs_close(&defaultVFS, file);
+
+    return info.sizeInBytes;
+}
+
+int test_entry__resource_manager_mmap(int argc, char** argv)
+{
+    static const char* pEncodedFilePaths[] = {
+        MMAP_TEST_WAV_PATH,
+        MMAP_TEST_MP3_PATH
+    };
+    ma_bool32 hasError = MA_FALSE;
+    ma_mmap_vfs mmapVFS;
+    ma_vfs_ex_callbacks exCallbacks;
+    ma_extended_vfs unmappableVFS;
+    ma_default_vfs defaultVFS;
+    ma_vfs_file file;
+    ma_uint64 fileSize;
+    size_t iFile;
+
+    (void)argc;
+    (void)argv;
+
+    if (test_resource_manager__create_directory(MMAP_TEST_DIRECTORY) != MA_SUCCESS ||
+        test_resource_manager__write_wav(MMAP_TEST_WAV_PATH,     ma_format_s16, 2, 44100, 44100) != MA_SUCCESS ||
+        test_resource_manager__write_wav(MMAP_TEST_F32_WAV_PATH, ma_format_f32, 2, 44100, 44100) != MA_SUCCESS ||
+        test_resource_manager__write_mp3(MMAP_TEST_MP3_PATH, 200) != MA_SUCCESS) {
+        printf("    Failed to generate test files.\n");
+        return -1;
+    }
+
+    ma_default_vfs_init(&defaultVFS, NULL);
+    if (ma_vfs_open(&defaultVFS, MMAP_TEST_EMPTY_PATH, MA_OPEN_MODE_WRITE, &file) != MA_SUCCESS) {
+        printf("    Failed to generate test files.\n");
+        return -1;
+    }
+    ma_vfs_close(&defaultVFS, file);
+
+    if (ma_mmap_vfs_init(&mmapVFS, NULL) != MA_SUCCESS) {
+        printf("    Failed to initialize the mmap VFS.\n");
+        return -1;
+    }
+
+    /* The same files through a VFS that has no way of mapping them. */
+    MA_ZERO_OBJECT(&exCallbacks);
+    exCallbacks.sizeInBytes = sizeof(exCallbacks);
+    ma_extended_vfs_init((ma_vfs*)&mmapVFS, &exCallbacks, &unmappableVFS);
+
+    for (iFile = 0; iFile < ma_countof(pEncodedFilePaths); iFile += 1) {
+        fileSize = test_mmap__get_file_size(pEncodedFilePaths[iFile]);
+
+        printf("    %s through ma_mmap_vfs\n", pEncodedFilePaths[iFile]);
+        if (test_mmap__check((ma_vfs*)&mmapVFS, pEncodedFilePaths[iFile], 0, MA_TRUE, 0) != MA_SUCCESS) {
+            hasError = MA_TRUE;
+        }
+
+        /* The encoded data is copied instead, and that copy is counted. */
+        printf("    %s through a VFS that can't map\n", pEncodedFilePaths[iFile]);
+        if (test_mmap__check((ma_vfs*)&unmappableVFS, pEncodedFilePaths[iFile], 0, MA_FALSE, fileSize) != MA_SUCCESS) {
+            hasError = MA_TRUE;
+        }
+    }
+
+    /* Frames that are already in the decoded format are read out of the mapping without being decoded into a buffer. */
+    printf("    %s decoded in place through ma_mmap_vfs\n", MMAP_TEST_F32_WAV_PATH);
+    if (test_mmap__check((ma_vfs*)&mmapVFS, MMAP_TEST_F32_WAV_PATH, MA_RESOURCE_MANAGER_DATA_SOURCE_FLAG_DECODE, MA_TRUE, 0) != MA_SUCCESS) {
+        hasError = MA_TRUE;
+    }
+
+    printf("    %s decoded through a VFS that can't map\n", MMAP_TEST_F32_WAV_PATH);
+    if (test_mmap__check((ma_vfs*)&unmappableVFS, MMAP_TEST_F32_WAV_PATH, MA_RESOURCE_MANAGER_DATA_SOURCE_FLAG_DECODE, MA_FALSE, 44100 * 2 * sizeof(float)) != MA_SUCCESS) {
+        hasError = MA_TRUE;
+    }
+
+    printf("    Files that can't be mapped\n");
+    if (test_mmap__check_unmapped_files(&mmapVFS) != MA_SUCCESS) {
+        hasError = MA_TRUE;
+    }
+
+    if (hasError) {
+        return -1;
+    }
+
+    return 0;
+}
@@ -0,0 +1,234 @@
+/* Several readers on their own threads share one file's pages, so they keep running into pages another reader is in the middle of decoding. */
+#define PAGE_CACHE_TEST_DIRECTORY       TEST_OUTPUT_DIR"/page_cache"
+#define PAGE_CACHE_TEST_F32_PATH        PAGE_CACHE_TEST_DIRECTORY"/f32.wav"
+#define PAGE_CACHE_TEST_S16_PATH        PAGE_CACHE_TEST_DIRECTORY"/s16.wav"
+#define PAGE_CACHE_TEST_READER_COUNT    4
+
+typedef struct
+{
+    ma_resource_manager_data_buffer dataBuffer;
+    const float* pExpectedFrames;
+    ma_uint64 frameCount;
+    ma_uint32 channels;
+    ma_bool32 isCorrect;
+} test_page_cache_reader;
+
+static ma_thread_result MA_THREADCALL test_page_cache__reader_thread(void* pUserData)
+{
+    test_page_cache_reader* pReader = (test_page_cache_reader*)pUserData;
+    float* pFrames;
+    ma_uint64 totalFramesRead = 0;
+
+    pFrames = (float*)ma_malloc((size_t)(pReader->frameCount * pReader->channels * sizeof(float)), NULL);
+    if (pFrames == NULL) {
+        return (ma_thread_result)0;
+    }
+
+    while (totalFramesRead < pReader->frameCount) {
+        ma_uint64 framesToRead = pReader->frameCount - totalFramesRead;
+        ma_uint64 framesRead;
+
+        if (framesToRead > 1000) {
+            framesToRead = 1000;
+        }
+
+        if (ma_resource_manager_data_buffer_read_pcm_frames(&pReader->dataBuffer, pFrames + totalFramesRead*pReader->channels, framesToRead, &framesRead) != MA_SUCCESS) {
+            break;
+        }
+
+        totalFramesRead += framesRead;
+    }
+
+    pReader->isCorrect = totalFramesRead == pReader->frameCount && memcmp(pFrames, pReader->pExpectedFrames, (size_t)(totalFramesRead * pReader->channels * sizeof(float))) == 0;
+
+    ma_free(pFrames, NULL);
+
+    return (ma_thread_result)0;
+}
+
+static ma_result test_page_cache__run(const char* pFilePath, ma_uint64 pageCacheSizeInBytes, ma_uint32 sampleRate)
+{
+    ma_result result;
+    ma_resource_manager_config resourceManagerConfig;
+    ma_resource_manager resourceManager;
+    ma_resource_manager_stats stats;
+    test_page_cache_reader readers[PAGE_CACHE_TEST_READER_COUNT];
+    ma_thread threads[PAGE_CACHE_TEST_READER_COUNT];
+    float* pExpectedFrames;
+    float* pFrames = NULL;
+    ma_uint64 length;
+    ma_uint64 baselineMemoryUsage;
+    ma_uint64 wholeFileSizeInBytes;
+    ma_uint64 cursor;
+    ma_uint64 availableFrames;
+    ma_uint64 framesRead;
+    ma_uint32 channels;
+    ma_uint32 readerCount = 0;
+    ma_uint32 iReader;
+    const char* pErrorMessage = NULL;
+
+    printf("    %s, %u byte cache, %u Hz\n", pFilePath, (unsigned int)pageCacheSizeInBytes, sampleRate);
+
+    resourceManagerConfig = test_resource_manager__config_init(1);
+    resourceManagerConfig.decodedSampleRate    = sampleRate;
+    resourceManagerConfig.pageCacheSizeInBytes = pageCacheSizeInBytes;
+
+    result = ma_resource_manager_init(&resourceManagerConfig, &resourceManager);
+    if (result != MA_SUCCESS) {
+        return result;
+    }
+
+    result = test_resource_manager__decode_file(pFilePath, sampleRate, &pExpectedFrames, &length, &channels);
+    if (result != MA_SUCCESS) {
+        ma_resource_manager_uninit(&resourceManager);
+        return result;
+    }
+
+    baselineMemoryUsage = ma_resource_manager_get_memory_usage_in_bytes(&resourceManager);
+
+    pFrames = (float*)ma_malloc((size_t)(length * channels * sizeof(float)), NULL);
+    if (pFrames == NULL) {
+        pErrorMessage = "Out of memory.";
+        goto done;
+    }
+
+    for (readerCount = 0; readerCount < PAGE_CACHE_TEST_READER_COUNT; readerCount += 1) {
+        readers[readerCount].pExpectedFrames = pExpectedFrames;
+        readers[readerCount].frameCount      = length;
+        readers[readerCount].channels        = channels;
+        readers[readerCount].isCorrect       = MA_FALSE;
+
+        if (ma_resource_manager_data_buffer_init(&resourceManager, pFilePath, 0, NULL, &readers[readerCount].dataBuffer) != MA_SUCCESS) {
+            pErrorMessage = "Failed to initialize a data buffer.";
+            goto done;
+        }
+    }
+
+    for (iReader = 0; iReader < readerCount; iReader += 1) {
+        ma_thread_create(&threads[iReader], ma_thread_priority_default, 0, test_page_cache__reader_thread, &readers[iReader], NULL);
+    }
+
+    for (iReader = 0; iReader < readerCount; iReader += 1) {
+        ma_thread_wait(&threads[iReader]);
+        if (!readers[iReader].isCorrect) {
+            pErrorMessage = "A data buffer read the wrong audio.";
+        }
+    }
+
+    if (pErrorMessage != NULL) {
+        goto done;
+    }
+
+    /* The length, cursor and available frames are only estimates when resampling so seeking and looping are only checked without it. */
+    if (sampleRate == 0) {
+        ma_resource_manager_data_buffer_seek_to_pcm_frame(&readers[0].dataBuffer, length/3);
+        ma_resource_manager_data_buffer_get_cursor_in_pcm_frames(&readers[0].dataBuffer, &cursor);
+        ma_resource_manager_data_buffer_get_available_frames(&readers[0].dataBuffer, &availableFrames);
+
+        if (cursor != length/3 || availableFrames != length - length/3) {
+            pErrorMessage = "Seeking did not update the cursor.";
+            goto done;
+        }
+
+        if (ma_resource_manager_data_buffer_read_pcm_frames(&readers[0].dataBuffer, pFrames, length, &framesRead) != MA_SUCCESS || framesRead != availableFrames ||
+            memcmp(pFrames, pExpectedFrames + (length/3)*channels, (size_t)(framesRead * channels * sizeof(float))) != 0) {
+            pErrorMessage = "Reading after a seek gave the wrong audio.";
+            goto done;
+        }
+
+        ma_resource_manager_data_buffer_set_looping(&readers[1].dataBuffer, MA_TRUE);
+        ma_resource_manager_data_buffer_seek_to_pcm_frame(&readers[1].dataBuffer, length - 10);
+
+        if (ma_resource_manager_data_buffer_read_pcm_frames(&readers[1].dataBuffer, pFrames, 30, &framesRead) != MA_SUCCESS || framesRead != 30 ||
+            memcmp(pFrames, pExpectedFrames + (length - 10)*channels, 10 * channels * sizeof(float)) != 0 ||
+            memcmp(pFrames + 10*channels, pExpectedFrames, 20 * channels * sizeof(float)) != 0) {
+            pErrorMessage = "Looping gave the wrong audio.";
+            goto done;
+        }
+    }
+
+    ma_resource_manager_get_stats(&resourceManager, &stats);
+
+    wholeFileSizeInBytes = ((length + MA_RESOURCE_MANAGER_PAGE_CACHE_PAGE_SIZE_IN_FRAMES - 1) / MA_RESOURCE_MANAGER_PAGE_CACHE_PAGE_SIZE_IN_FRAMES) * MA_RESOURCE_MANAGER_PAGE_CACHE_PAGE_SIZE_IN_FRAMES * channels * sizeof(float);
+
+    if (stats.pageCacheSizeInBytes > pageCacheSizeInBytes) {
+        pErrorMessage = "The page cache went over its budget.";
+        goto done;
+    }
+
+    if ((sampleRate != 0 || pageCacheSizeInBytes == 0) && (stats.pageCacheSizeInBytes != 0 || stats.pageCacheHitCount != 0)) {
+        pErrorMessage = "The page cache was used while disabled or resampling.";
+        goto done;
+    }
+
+    if (sampleRate == 0 && pageCacheSizeInBytes > 0 && stats.pageCacheSizeInBytes == 0) {
+        pErrorMessage = "The page cache was not used.";
+        goto done;
+    }
+
+    if (sampleRate == 0 && pageCacheSizeInBytes >= wholeFileSizeInBytes && (stats.pageCacheSizeInBytes != wholeFileSizeInBytes || stats.pageCacheHitCount <= stats.pageCacheMissCount)) {
+        pErrorMessage = "The data buffers did not share the page cache.";
+        goto done;
+    }
+
+done:
+    for (iReader = 0; iReader < readerCount; iReader += 1) {
+        ma_resource_manager_data_buffer_uninit(&readers[iReader].dataBuffer);
+    }
+
+    if (pErrorMessage == NULL) {
+        ma_resource_manager_get_stats(&resourceManager, &stats);
+        if (stats.pageCacheSizeInBytes != 0 || ma_resource_manager_get_memory_usage_in_bytes(&resourceManager) != baselineMemoryUsage) {
+            pErrorMessage = "The page cache was not freed with the last data buffer.";
+        }
+    }
+
+    ma_resource_manager_uninit(&resourceManager);
+    ma_free(pFrames, NULL);
+    ma_free(pExpectedFrames, NULL);
+
+    return test_resource_manager__report(pErrorMessage);
+}
+
+int test_entry__resource_manager_page_cache(int argc, char** argv)
+{
+    ma_bool32 hasError = MA_FALSE;
+
+    (void)argc;
+    (void)argv;
+
+    if (test_resource_manager__create_directory(PAGE_CACHE_TEST_DIRECTORY) != MA_SUCCESS ||
+        test_resource_manager__write_wav(PAGE_CACHE_TEST_F32_PATH, ma_format_f32, 2, 48000, 48000*3) != MA_SUCCESS ||
+        test_resource_manager__write_wav(PAGE_CACHE_TEST_S16_PATH, ma_format_s16, 1, 44100, 44100*2 + 123) != MA_SUCCESS) {
+        printf("    Failed to generate test files.\n");
+        return -1;
+    }
+
+    if (test_page_cache__run(PAGE_CACHE_TEST_F32_PATH, 1 << 30, 0) != MA_SUCCESS) {
+        hasError = MA_TRUE;
+    }
+
+    if (test_page_cache__run(PAGE_CACHE_TEST_S16_PATH, 1 << 30, 0) != MA_SUCCESS) {
+        hasError = MA_TRUE;
+    }
+
+    /* Only part of the file fits. */
+    if (test_page_cache__run(PAGE_CACHE_TEST_S16_PATH, 100000, 0) != MA_SUCCESS) {
+        hasError = MA_TRUE;
+    }
+
+    /* No cache at all. */
+    if (test_page_cache__run(PAGE_CACHE_TEST_S16_PATH, 0, 0) != MA_SUCCESS) {
+        hasError = MA_TRUE;
+    }
+
+    if (test_page_cache__run(PAGE_CACHE_TEST_S16_PATH, 1 << 30, 48000) != MA_SUCCESS) {
+        hasError = MA_TRUE;
+    }
+
+    if (hasError) {
+        return -1;
+    }
+
+    return 0;
+}
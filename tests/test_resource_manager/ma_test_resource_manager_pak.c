@@ -0,0 +1,303 @@
+/* Archives are checked against the loose files they were built from, both byte for byte and as audio loaded by the resource manager. */
+#define PAK_TEST_DIRECTORY      TEST_OUTPUT_DIR"/pak"
+#define PAK_TEST_ARCHIVE_PATH   PAK_TEST_DIRECTORY"/test.pak"
+#define PAK_TEST_S16_PATH       PAK_TEST_DIRECTORY"/s16.wav"
+#define PAK_TEST_F32_PATH       PAK_TEST_DIRECTORY"/f32.wav"
+#define PAK_TEST_NOTE_COUNT     40      /* Enough small entries to force collisions in the index. */
+#define PAK_TEST_ALIGNMENT      16
+
+/* Reads a file out of the archive in small, odd sized chunks so that reads straddle every boundary. */
+static ma_result test_pak__check_file_contents(ma_pak_vfs* pPak, const char* pName, const void* pExpectedData, size_t expectedSize)
+{
+    ma_result result;
+    ma_vfs_file file;
+    ma_uint8* pData;
+    size_t totalBytesRead = 0;
+    ma_int64 cursor;
+    ma_file_info info;
+
+    result = ma_vfs_open(pPak, pName, MA_OPEN_MODE_READ, &file);
+    if (result != MA_SUCCESS) {
+        printf("    Failed to open \"%s\" in the archive.\n", pName);
+        return result;
+    }
+
+    pData = (ma_uint8*)ma_malloc(expectedSize + 64, NULL);
+    if (pData == NULL) {
+        ma_vfs_close(pPak, file);
+        return MA_OUT_OF_MEMORY;
+    }
+
+    result = ma_vfs_info(pPak, file, &info);
+    if (result != MA_SUCCESS || info.sizeInBytes != expectedSize) {
+        printf("    \"%s\": wrong size.\n", pName);
+        result = MA_ERROR;
+        goto done;
+    }
+
+    for (;;) {
+        size_t bytesRead;
+
+        result = ma_vfs_read(pPak, file, pData + totalBytesRead, 7, &bytesRead);
+        totalBytesRead += bytesRead;
+
+        if (result != MA_SUCCESS || totalBytesRead > expectedSize) {
+            break;
+        }
+    }
+
+    if (result != MA_AT_END || totalBytesRead != expectedSize || memcmp(pData, pExpectedData, expectedSize) != 0) {
+        printf("    \"%s\": contents do not match.\n", pName);
+        result = MA_ERROR;
+        goto done;
+    }
+
+    /* Seeking is relative to the file, not the archive. */
+    if (expectedSize > 10) {
+        size_t bytesRead;
+
+        ma_vfs_seek(pPak, file, -10, ma_seek_origin_end);
+        ma_vfs_tell(pPak, file, &cursor);
+
+        result = ma_vfs_read(pPak, file, pData, 10, &bytesRead);
+        if (cursor != (ma_int64)expectedSize - 10 || result != MA_SUCCESS || bytesRead != 10 || memcmp(pData, (const ma_uint8*)pExpectedData + expectedSize - 10, 10) != 0) {
+            printf("    \"%s\": seeking from the end failed.\n", pName);
+            result = MA_ERROR;
+            goto done;
+        }
+    }
+
+    result = MA_SUCCESS;
+
+done:
+    ma_free(pData, NULL);
+    ma_vfs_close(pPak, file);
+    return result;
+}
+
+static ma_result test_pak__load(ma_vfs* pVFS, const char* pName, ma_uint32 flags, float* pFrames, ma_uint64 frameCap, ma_uint64* pFramesRead)
+{
+    ma_result result;
+    ma_resource_manager_config resourceManagerConfig;
+    ma_resource_manager resourceManager;
+    ma_resource_manager_data_source dataSource;
+    ma_uint32 channels;
+
+    resourceManagerConfig = test_resource_manager__config_init(1);
+    resourceManagerConfig.pVFS = pVFS;
+
+    result = ma_resource_manager_init(&resourceManagerConfig, &resourceManager);
+    if (result != MA_SUCCESS) {
+        return result;
+    }
+
+    result = ma_resource_manager_data_source_init(&resourceManager, pName, flags, NULL, &dataSource);
+    if (result == MA_SUCCESS) {
+        ma_data_source_get_data_format(&dataSource, NULL, &channels, NULL, NULL, 0);
+        *pFramesRead = test_resource_manager__read_all(&dataSource, pFrames, channels, frameCap);
+        ma_resource_manager_data_source_uninit(&dataSource);
+    }
+
+    ma_resource_manager_uninit(&resourceManager);
+
+    return result;
+}
+
+static ma_result test_pak__compare_loads(ma_pak_vfs* pPak, const char* pName, const char* pFilePath)
+{
+    ma_result result;
+    ma_uint32 flags[3] = { 0, MA_RESOURCE_MANAGER_DATA_SOURCE_FLAG_STREAM, MA_RESOURCE_MANAGER_DATA_SOURCE_FLAG_DECODE };
+    float* pExpectedFrames;
+    float* pFrames;
+    ma_uint64 expectedFrameCount;
+    ma_uint64 framesRead;
+    ma_uint32 channels;
+    ma_uint32 iFlags;
+
+    result = test_resource_manager__decode_file(pFilePath, 0, &pExpectedFrames, &expectedFrameCount, &channels);
+    if (result != MA_SUCCESS) {
+        return result;
+    }
+
+    /* A little extra room so reading too much is caught. */
+    pFrames = (float*)ma_malloc((size_t)((expectedFrameCount + 64) * channels * sizeof(float)), NULL);
+    if (pFrames == NULL) {
+        ma_free(pExpectedFrames, NULL);
+        return MA_OUT_OF_MEMORY;
+    }
+
+    for (iFlags = 0; iFlags < ma_countof(flags); iFlags += 1) {
+        result = test_pak__load((ma_vfs*)pPak, pName, flags[iFlags], pFrames, expectedFrameCount + 64, &framesRead);
+        if (result != MA_SUCCESS) {
+            printf("    \"%s\", flags 0x%x: failed to load from the archive: %s.\n", pName, flags[iFlags], ma_result_description(result));
+            break;
+        }
+
+        if (framesRead != expectedFrameCount || memcmp(pFrames, pExpectedFrames, (size_t)(framesRead * channels * sizeof(float))) != 0) {
+            printf("    \"%s\", flags 0x%x: audio loaded from the archive does not match the loose file.\n", pName, flags[iFlags]);
+            result = MA_ERROR;
+            break;
+        }
+    }
+
+    ma_free(pFrames, NULL);
+    ma_free(pExpectedFrames, NULL);
+
+    return result;
+}
+
+int test_entry__resource_manager_pak(int argc, char** argv)
+{
+    ma_result result;
+    ma_bool32 hasError = MA_FALSE;
+    ma_pak_write_entry entries[2 + PAK_TEST_NOTE_COUNT];
+    ma_pak_write_entry duplicateEntries[2];
+    char names[PAK_TEST_NOTE_COUNT][32];
+    char notes[PAK_TEST_NOTE_COUNT][32];
+    void* pS16Data = NULL;
+    void* pF32Data = NULL;
+    size_t s16DataSize;
+    size_t f32DataSize;
+    ma_pak_vfs pak;
+    ma_pak_vfs_entry_info info;
+    ma_vfs_file file;
+    ma_uint32 iEntry;
+
+    (void)argc;
+    (void)argv;
+
+    if (test_resource_manager__create_directory(PAK_TEST_DIRECTORY) != MA_SUCCESS ||
+        test_resource_manager__write_wav(PAK_TEST_S16_PATH, ma_format_s16, 2, 44100, 50000) != MA_SUCCESS ||
+        test_resource_manager__write_wav(PAK_TEST_F32_PATH, ma_format_f32, 1, 48000, 30000) != MA_SUCCESS) {
+        printf("    Failed to generate test files.\n");
+        return -1;
+    }
+
+    if (ma_vfs_open_and_read_file(NULL, PAK_TEST_S16_PATH, &pS16Data, &s16DataSize, NULL) != MA_SUCCESS ||
+        ma_vfs_open_and_read_file(NULL, PAK_TEST_F32_PATH, &pF32Data, &f32DataSize, NULL) != MA_SUCCESS) {
+        printf("    Failed to read test files.\n");
+        ma_free(pS16Data, NULL);
+        return -1;
+    }
+
+    /* The audio is copied from the loose files and the notes from memory. */
+    MA_ZERO_MEMORY(entries, sizeof(entries));
+
+    entries[0].pName          = "sfx/s16.wav";
+    entries[0].pFilePath      = PAK_TEST_S16_PATH;
+    entries[0].encodingFormat = ma_encoding_format_wav;
+
+    entries[1].pName          = "music\\f32.wav";
+    entries[1].pFilePath      = PAK_TEST_F32_PATH;
+    entries[1].encodingFormat = ma_encoding_format_wav;
+
+    for (iEntry = 0; iEntry < PAK_TEST_NOTE_COUNT; iEntry += 1) {
+        sprintf(names[iEntry], "notes/%u.txt", iEntry);
+        sprintf(notes[iEntry], "note number %u", iEntry * 7919);
+        entries[2 + iEntry].pName           = names[iEntry];
+        entries[2 + iEntry].pData           = notes[iEntry];
+        entries[2 + iEntry].dataSizeInBytes = strlen(notes[iEntry]);
+        entries[2 + iEntry].encodingFormat  = ma_encoding_format_unknown;
+    }
+
+    duplicateEntries[0] = entries[0];
+    duplicateEntries[1] = entries[2];
+    duplicateEntries[1].pName = "sfx\\s16.wav";
+
+    if (ma_pak_write_file(NULL, PAK_TEST_ARCHIVE_PATH, duplicateEntries, ma_countof(duplicateEntries), PAK_TEST_ALIGNMENT, NULL) != MA_ALREADY_EXISTS) {
+        printf("    Writing an archive with two entries of the same name did not fail with MA_ALREADY_EXISTS.\n");
+        hasError = MA_TRUE;
+    }
+
+    result = ma_pak_write_file(NULL, PAK_TEST_ARCHIVE_PATH, entries, ma_countof(entries), PAK_TEST_ALIGNMENT, NULL);
+    if (result != MA_SUCCESS) {
+        printf("    Failed to write the archive: %s.\n", ma_result_description(result));
+        hasError = MA_TRUE;
+        goto done;
+    }
+
+    result = ma_pak_vfs_init_file(PAK_TEST_ARCHIVE_PATH, NULL, &pak);
+    if (result != MA_SUCCESS) {
+        printf("    Failed to open the archive: %s.\n", ma_result_description(result));
+        hasError = MA_TRUE;
+        goto done;
+    }
+
+    /* Lookups. Backslashes are treated as forward slashes. */
+    result = ma_pak_vfs_find(&pak, "sfx\\s16.wav", &info);
+    if (result != MA_SUCCESS || info.sizeInBytes != s16DataSize || info.encodingFormat != ma_encoding_format_wav || (info.offset % PAK_TEST_ALIGNMENT) != 0) {
+        printf("    Finding an entry by a name with backslashes failed.\n");
+        hasError = MA_TRUE;
+    }
+
+    if (ma_pak_vfs_find(&pak, "sfx/missing.wav", &info) != MA_DOES_NOT_EXIST || ma_pak_vfs_find(&pak, "sfx/s16.wa", &info) != MA_DOES_NOT_EXIST) {
+        printf("    Finding a missing entry did not fail with MA_DOES_NOT_EXIST.\n");
+        hasError = MA_TRUE;
+    }
+
+    if (ma_vfs_open(&pak, "sfx/s16.wav", MA_OPEN_MODE_WRITE, &file) == MA_SUCCESS) {
+        printf("    Opening an entry for writing succeeded.\n");
+        ma_vfs_close(&pak, file);
+        hasError = MA_TRUE;
+    }
+
+    if (test_pak__check_file_contents(&pak, "sfx/s16.wav", pS16Data, s16DataSize) != MA_SUCCESS) {
+        hasError = MA_TRUE;
+    }
+
+    if (test_pak__check_file_contents(&pak, "music/f32.wav", pF32Data, f32DataSize) != MA_SUCCESS) {
+        hasError = MA_TRUE;
+    }
+
+    for (iEntry = 0; iEntry < PAK_TEST_NOTE_COUNT; iEntry += 1) {
+        if (test_pak__check_file_contents(&pak, names[iEntry], notes[iEntry], strlen(notes[iEntry])) != MA_SUCCESS) {
+            hasError = MA_TRUE;
+        }
+    }
+
+    /* Wide character names are converted to UTF-8. Mapping is only available when the archive itself is mapped. */
+    result = ma_vfs_open_w(&pak, L"music/f32.wav", MA_OPEN_MODE_READ, &file);
+    if (result != MA_SUCCESS) {
+        printf("    Opening an entry by a wide character name failed.\n");
+        hasError = MA_TRUE;
+    } else {
+        const void* pMappedData;
+        size_t mappedSize;
+
+        if (pak.pArchiveData != NULL) {
+            if (ma_vfs_map(&pak, file, &pMappedData, &mappedSize) != MA_SUCCESS || mappedSize != f32DataSize || memcmp(pMappedData, pF32Data, f32DataSize) != 0) {
+                printf("    Mapping an entry failed.\n");
+                hasError = MA_TRUE;
+            }
+        }
+
+        ma_vfs_close(&pak, file);
+    }
+
+    if (test_pak__compare_loads(&pak, "sfx/s16.wav", PAK_TEST_S16_PATH) != MA_SUCCESS) {
+        hasError = MA_TRUE;
+    }
+
+    if (test_pak__compare_loads(&pak, "music/f32.wav", PAK_TEST_F32_PATH) != MA_SUCCESS) {
+        hasError = MA_TRUE;
+    }
+
+    ma_pak_vfs_uninit(&pak);
+
+    /* Anything that isn't an archive must be rejected. */
+    if (ma_pak_vfs_init_file(PAK_TEST_S16_PATH, NULL, &pak) == MA_SUCCESS) {
+        printf("    Opening a file that isn't an archive succeeded.\n");
+        ma_pak_vfs_uninit(&pak);
+        hasError = MA_TRUE;
+    }
+
+done:
+    ma_free(pS16Data, NULL);
+    ma_free(pF32Data, NULL);
+
+    if (hasError) {
+        return -1;
+    }
+
+    return 0;
+}
@@ -0,0 +1,133 @@
+/*
+Long sounds are decoded in ranges when the resource manager has more than one job thread. Each range opens its own decoder in its own
+job, and the stitched together result has to be exactly what a single decoder gives.
+*/
+#define PARALLEL_DECODE_TEST_DIRECTORY      TEST_OUTPUT_DIR"/parallel_decode"
+#define PARALLEL_DECODE_TEST_WAV_PATH       PARALLEL_DECODE_TEST_DIRECTORY"/test.wav"
+#define PARALLEL_DECODE_TEST_ODD_WAV_PATH   PARALLEL_DECODE_TEST_DIRECTORY"/odd.wav"
+#define PARALLEL_DECODE_TEST_MP3_PATH       PARALLEL_DECODE_TEST_DIRECTORY"/test.mp3"
+#define PARALLEL_DECODE_TEST_SEEK_POINTS    64
+
+static ma_result test_parallel_decode__check(const char* pFilePath, ma_uint32 jobThreadCount, ma_uint32 seekPointCount)
+{
+    ma_result result;
+    ma_resource_manager_config resourceManagerConfig;
+    ma_resource_manager resourceManager;
+    ma_resource_manager_data_source dataSource;
+    ma_resource_manager_pipeline_notifications notifications;
+    ma_fence fence;
+    float* pExpectedFrames;
+    float* pFrames = NULL;
+    ma_uint64 expectedLength;
+    ma_uint64 framesRead;
+    ma_uint32 channels;
+    const char* pErrorMessage = NULL;
+
+    printf("    %s on %u threads\n", pFilePath, jobThreadCount);
+
+    result = test_resource_manager__decode_file(pFilePath, 0, &pExpectedFrames, &expectedLength, &channels);
+    if (result != MA_SUCCESS) {
+        printf("    Failed to decode the reference.\n");
+        return result;
+    }
+
+    resourceManagerConfig = test_resource_manager__config_init(jobThreadCount);
+    resourceManagerConfig.seekPointCount = seekPointCount;
+
+    result = ma_resource_manager_init(&resourceManagerConfig, &resourceManager);
+    if (result != MA_SUCCESS) {
+        printf("    Failed to initialize the resource manager.\n");
+        ma_free(pExpectedFrames, NULL);
+        return result;
+    }
+
+    /*
+    The fence is released by whichever range finishes last. A decoded buffer hands out frames that haven't been decoded yet as silence so
+    nothing can be compared until then.
+    */
+    ma_fence_init(&fence);
+    notifications = ma_resource_manager_pipeline_notifications_init();
+    notifications.done.pFence = &fence;
+
+    result = ma_resource_manager_data_source_init(&resourceManager, pFilePath, MA_RESOURCE_MANAGER_DATA_SOURCE_FLAG_DECODE | MA_RESOURCE_MANAGER_DATA_SOURCE_FLAG_ASYNC, &notifications, &dataSource);
+    if (result != MA_SUCCESS) {
+        printf("    Failed to load through the resource manager.\n");
+        ma_fence_uninit(&fence);
+        ma_resource_manager_uninit(&resourceManager);
+        ma_free(pExpectedFrames, NULL);
+        return result;
+    }
+
+    ma_fence_wait(&fence);
+
+    if (ma_resource_manager_data_source_result(&dataSource) != MA_SUCCESS) {
+        pErrorMessage = "Failed to decode through the resource manager.";
+        goto done;
+    }
+
+    pFrames = (float*)ma_malloc((size_t)(expectedLength * channels * sizeof(float)), NULL);
+    if (pFrames == NULL) {
+        pErrorMessage = "Out of memory.";
+        goto done;
+    }
+
+    framesRead = test_resource_manager__read_all(&dataSource, pFrames, channels, expectedLength);
+    if (framesRead != expectedLength || memcmp(pFrames, pExpectedFrames, (size_t)(framesRead * channels * sizeof(float))) != 0) {
+        pErrorMessage = "The sound decoded differently to a single decoder.";
+        goto done;
+    }
+
+done:
+    ma_resource_manager_data_source_uninit(&dataSource);
+    ma_fence_uninit(&fence);
+    ma_resource_manager_uninit(&resourceManager);
+    ma_free(pFrames, NULL);
+    ma_free(pExpectedFrames, NULL);
+
+    return test_resource_manager__report(pErrorMessage);
+}
+
+int test_entry__resource_manager_parallel_decode(int argc, char** argv)
+{
+    ma_bool32 hasError = MA_FALSE;
+
+    (void)argc;
+    (void)argv;
+
+    /* Long enough for several ranges of MA_RESOURCE_MANAGER_MIN_DECODE_RANGE_IN_MILLISECONDS each. An odd length leaves a short last range. */
+    if (test_resource_manager__create_directory(PARALLEL_DECODE_TEST_DIRECTORY) != MA_SUCCESS ||
+        test_resource_manager__write_wav(PARALLEL_DECODE_TEST_WAV_PATH,     ma_format_s16, 2, 44100, 44100*45)      != MA_SUCCESS ||
+        test_resource_manager__write_wav(PARALLEL_DECODE_TEST_ODD_WAV_PATH, ma_format_f32, 1, 22050, 22050*33 + 17) != MA_SUCCESS ||
+        test_resource_manager__write_mp3(PARALLEL_DECODE_TEST_MP3_PATH, 2000) != MA_SUCCESS) {
+        printf("    Failed to generate test files.\n");
+        return -1;
+    }
+
+    if (test_parallel_decode__check(PARALLEL_DECODE_TEST_WAV_PATH, 4, 0) != MA_SUCCESS) {
+        hasError = MA_TRUE;
+    }
+
+    if (test_parallel_decode__check(PARALLEL_DECODE_TEST_ODD_WAV_PATH, 3, 0) != MA_SUCCESS) {
+        hasError = MA_TRUE;
+    }
+
+    /* More threads than there are ranges. */
+    if (test_parallel_decode__check(PARALLEL_DECODE_TEST_WAV_PATH, 8, 0) != MA_SUCCESS) {
+        hasError = MA_TRUE;
+    }
+
+    /* An MP3 is only split when it has a seek table. Without one it's decoded by the paging job alone. */
+    if (test_parallel_decode__check(PARALLEL_DECODE_TEST_MP3_PATH, 4, PARALLEL_DECODE_TEST_SEEK_POINTS) != MA_SUCCESS) {
+        hasError = MA_TRUE;
+    }
+
+    if (test_parallel_decode__check(PARALLEL_DECODE_TEST_MP3_PATH, 4, 0) != MA_SUCCESS) {
+        hasError = MA_TRUE;
+    }
+
+    if (hasError) {
+        return -1;
+    }
+
+    return 0;
+}
@@ -0,0 +1,309 @@
+/* Decoding on several threads has to give exactly what decoding on one thread gives, including for the files that can't be split. */
+#define PARALLEL_FLAC_TEST_DIRECTORY    TEST_OUTPUT_DIR"/parallel_flac"
+#define PARALLEL_FLAC_TEST_CHANNELS     2
+#define PARALLEL_FLAC_TEST_SAMPLE_RATE  44100
+
+/*
+There's no FLAC encoder so files are put together by hand out of verbatim subframes. They're 16-bit stereo at 44.1 kHz with the block
+size stored at the end of each frame header. Variable block size frames store the sample number rather than the frame number.
+*/
+static ma_uint8 test_parallel_flac__crc8(const ma_uint8* pData, size_t dataSize)
+{
+    ma_uint8 crc = 0;
+    size_t iByte;
+    int iBit;
+
+    for (iByte = 0; iByte < dataSize; iByte += 1) {
+        crc ^= pData[iByte];
+        for (iBit = 0; iBit < 8; iBit += 1) {
+            crc = (ma_uint8)((crc & 0x80) ? ((crc << 1) ^ 0x07) : (crc << 1));
+        }
+    }
+
+    return crc;
+}
+
+static ma_uint16 test_parallel_flac__crc16(const ma_uint8* pData, size_t dataSize)
+{
+    ma_uint16 crc = 0;
+    size_t iByte;
+    int iBit;
+
+    for (iByte = 0; iByte < dataSize; iByte += 1) {
+        crc ^= (ma_uint16)(pData[iByte] << 8);
+        for (iBit = 0; iBit < 8; iBit += 1) {
+            crc = (ma_uint16)((crc & 0x8000) ? ((crc << 1) ^ 0x8005) : (crc << 1));
+        }
+    }
+
+    return crc;
+}
+
+/* The frame or sample number in the frame header is coded like UTF-8. Returns the number of bytes written. */
+static size_t test_parallel_flac__write_coded_number(ma_uint8* pOut, ma_uint32 value)
+{
+    if (value < 0x80) {
+        pOut[0] = (ma_uint8)value;
+        return 1;
+    }
+    if (value < 0x800) {
+        pOut[0] = (ma_uint8)(0xC0 | (value >> 6));
+        pOut[1] = (ma_uint8)(0x80 | (value & 0x3F));
+        return 2;
+    }
+    if (value < 0x10000) {
+        pOut[0] = (ma_uint8)(0xE0 | (value >> 12));
+        pOut[1] = (ma_uint8)(0x80 | ((value >> 6) & 0x3F));
+        pOut[2] = (ma_uint8)(0x80 | (value & 0x3F));
+        return 3;
+    }
+
+    pOut[0] = (ma_uint8)(0xF0 | (value >> 18));
+    pOut[1] = (ma_uint8)(0x80 | ((value >> 12) & 0x3F));
+    pOut[2] = (ma_uint8)(0x80 | ((value >> 6) & 0x3F));
+    pOut[3] = (ma_uint8)(0x80 | (value & 0x3F));
+    return 4;
+}
+
+static ma_result test_parallel_flac__write(const char* pFilePath, ma_uint32 totalFrameCount, ma_uint32 blockSize, ma_bool32 storeTotalFrameCount, ma_bool32 isVariableBlockSize, ma_bool32 isTruncated)
+{
+    ma_uint8 header[4 + 4 + 34];
+    ma_uint8* pFrame;
+    ma_uint64 streamInfo;
+    ma_uint32 framesWritten = 0;
+    ma_uint32 frameIndex = 0;
+    ma_lcg lcg;
+    FILE* pFile;
+    int iByte;
+
+    pFrame = (ma_uint8*)ma_malloc(16 + PARALLEL_FLAC_TEST_CHANNELS * (1 + blockSize * 2), NULL);
+    if (pFrame == NULL) {
+        return MA_OUT_OF_MEMORY;
+    }
+
+    if (ma_fopen(&pFile, pFilePath, "wb") != MA_SUCCESS) {
+        ma_free(pFrame, NULL);
+        return MA_IO_ERROR;
+    }
+
+    ma_lcg_seed(&lcg, 1);
+
+    /* The stream marker and a STREAMINFO block that's also the last metadata block. The frame sizes and MD5 are left as unknown. */
+    MA_ZERO_MEMORY(header, sizeof(header));
+    header[0] = 'f';
+    header[1] = 'L';
+    header[2] = 'a';
+    header[3] = 'C';
+    header[4] = 0x80;
+    header[7] = 34;
+    header[8]  = (ma_uint8)(blockSize >> 8);
+    header[9]  = (ma_uint8)(blockSize & 0xFF);
+    header[10] = (ma_uint8)(blockSize >> 8);
+    header[11] = (ma_uint8)(blockSize & 0xFF);
+
+    streamInfo = ((ma_uint64)PARALLEL_FLAC_TEST_SAMPLE_RATE << 44) | ((ma_uint64)(PARALLEL_FLAC_TEST_CHANNELS - 1) << 41) | ((ma_uint64)15 << 36) | (storeTotalFrameCount ? totalFrameCount : 0);
+    for (iByte = 0; iByte < 8; iByte += 1) {
+        header[18 + iByte] = (ma_uint8)(streamInfo >> (56 - iByte*8));
+    }
+
+    fwrite(header, 1, sizeof(header), pFile);
+
+    while (framesWritten < totalFrameCount) {
+        ma_uint32 frameBlockSize = blockSize;
+        ma_uint32 iChannel;
+        ma_uint32 iSample;
+        size_t frameSize;
+        ma_uint16 crc16;
+
+        if (isVariableBlockSize) {
+            switch (ma_lcg_rand_u32(&lcg) % 4) {
+                case 0:  frameBlockSize = blockSize;     break;
+                case 1:  frameBlockSize = blockSize / 2; break;
+                case 2:  frameBlockSize = 1000;          break;
+                default: frameBlockSize = 1234;          break;
+            }
+        }
+
+        if (frameBlockSize > totalFrameCount - framesWritten) {
+            frameBlockSize = totalFrameCount - framesWritten;
+        }
+
+        /* Sync code, blocking strategy, 16-bit block size at the end of the header, 44.1 kHz, independent stereo, 16 bits per sample. */
+        pFrame[0] = 0xFF;
+        pFrame[1] = isVariableBlockSize ? 0xF9 : 0xF8;
+        pFrame[2] = 0x79;
+        pFrame[3] = 0x18;
+        frameSize = 4 + test_parallel_flac__write_coded_number(pFrame + 4, isVariableBlockSize ? framesWritten : frameIndex);
+        pFrame[frameSize + 0] = (ma_uint8)((frameBlockSize - 1) >> 8);
+        pFrame[frameSize + 1] = (ma_uint8)((frameBlockSize - 1) & 0xFF);
+        frameSize += 2;
+        pFrame[frameSize] = test_parallel_flac__crc8(pFrame, frameSize);
+        frameSize += 1;
+
+        for (iChannel = 0; iChannel < PARALLEL_FLAC_TEST_CHANNELS; iChannel += 1) {
+            pFrame[frameSize] = 0x02;   /* Verbatim subframe. */
+            frameSize += 1;
+
+            for (iSample = 0; iSample < frameBlockSize; iSample += 1) {
+                ma_int16 sample = (ma_int16)(ma_lcg_rand_s32(&lcg) >> 17);
+                pFrame[frameSize + 0] = (ma_uint8)((ma_uint16)sample >> 8);
+                pFrame[frameSize + 1] = (ma_uint8)((ma_uint16)sample & 0xFF);
+                frameSize += 2;
+            }
+        }
+
+        crc16 = test_parallel_flac__crc16(pFrame, frameSize);
+        pFrame[frameSize + 0] = (ma_uint8)(crc16 >> 8);
+        pFrame[frameSize + 1] = (ma_uint8)(crc16 & 0xFF);
+        frameSize += 2;
+
+        framesWritten += frameBlockSize;
+        frameIndex    += 1;
+
+        /* A truncated file stops in the middle of the frame two thirds of the way through. */
+        if (isTruncated && framesWritten >= (totalFrameCount / 3) * 2) {
+            fwrite(pFrame, 1, frameSize / 2, pFile);
+            break;
+        }
+
+        fwrite(pFrame, 1, frameSize, pFile);
+    }
+
+    fclose(pFile);
+    ma_free(pFrame, NULL);
+
+    return MA_SUCCESS;
+}
+
+static ma_result test_parallel_flac__compare(const char* pFilePath, ma_format format, ma_uint32 channels, ma_uint32 sampleRate, ma_uint32 decodeThreadCount)
+{
+    ma_result result;
+    ma_decoder_config sequentialConfig;
+    ma_decoder_config parallelConfig;
+    ma_default_vfs vfs;
+    void* pFileData;
+    size_t fileDataSize;
+    void* pSequentialFrames;
+    void* pParallelFrames[3] = { NULL, NULL, NULL };
+    ma_uint64 sequentialFrameCount;
+    ma_uint64 parallelFrameCount[3];
+    size_t bytesPerFrame;
+    int iMethod;
+
+    sequentialConfig = ma_decoder_config_init(format, channels, sampleRate);
+    result = ma_decode_file(pFilePath, &sequentialConfig, &sequentialFrameCount, &pSequentialFrames);
+    if (result != MA_SUCCESS) {
+        printf("    Failed to decode \"%s\" on one thread.\n", pFilePath);
+        return result;
+    }
+
+    result = ma_vfs_open_and_read_file(NULL, pFilePath, &pFileData, &fileDataSize, NULL);
+    if (result != MA_SUCCESS) {
+        ma_free(pSequentialFrames, NULL);
+        return result;
+    }
+
+    ma_default_vfs_init(&vfs, NULL);
+
+    for (iMethod = 0; iMethod < 3; iMethod += 1) {
+        parallelConfig = ma_decoder_config_init(format, channels, sampleRate);
+        parallelConfig.decodeThreadCount = decodeThreadCount;
+
+        if (iMethod == 0) {
+            result = ma_decode_file(pFilePath, &parallelConfig, &parallelFrameCount[iMethod], &pParallelFrames[iMethod]);
+        } else if (iMethod == 1) {
+            result = ma_decode_from_vfs(&vfs, pFilePath, &parallelConfig, &parallelFrameCount[iMethod], &pParallelFrames[iMethod]);
+        } else {
+            result = ma_decode_memory(pFileData, fileDataSize, &parallelConfig, &parallelFrameCount[iMethod], &pParallelFrames[iMethod]);
+        }
+
+        if (result != MA_SUCCESS) {
+            printf("    Failed to decode \"%s\" on %u threads.\n", pFilePath, decodeThreadCount);
+            break;
+        }
+
+        /* The output format is written back to the config when it's left as the native format. */
+        if (parallelConfig.format != sequentialConfig.format || parallelConfig.channels != sequentialConfig.channels || parallelConfig.sampleRate != sequentialConfig.sampleRate) {
+            printf("    \"%s\" decoded to a different format on %u threads.\n", pFilePath, decodeThreadCount);
+            result = MA_ERROR;
+            break;
+        }
+
+        bytesPerFrame = ma_get_bytes_per_frame(sequentialConfig.format, sequentialConfig.channels);
+        if (parallelFrameCount[iMethod] != sequentialFrameCount || memcmp(pParallelFrames[iMethod], pSequentialFrames, (size_t)(sequentialFrameCount * bytesPerFrame)) != 0) {
+            printf("    \"%s\" decoded differently on %u threads.\n", pFilePath, decodeThreadCount);
+            result = MA_ERROR;
+            break;
+        }
+    }
+
+    for (iMethod = 0; iMethod < 3; iMethod += 1) {
+        ma_free(pParallelFrames[iMethod], NULL);
+    }
+
+    ma_free(pFileData, NULL);
+    ma_free(pSequentialFrames, NULL);
+
+    return result;
+}
+
+int test_entry__resource_manager_parallel_flac(int argc, char** argv)
+{
+    static const char* pFilePaths[] = {
+        PARALLEL_FLAC_TEST_DIRECTORY"/test.flac",
+        PARALLEL_FLAC_TEST_DIRECTORY"/odd.flac",
+        PARALLEL_FLAC_TEST_DIRECTORY"/no_total.flac",
+        PARALLEL_FLAC_TEST_DIRECTORY"/variable.flac",
+        PARALLEL_FLAC_TEST_DIRECTORY"/short.flac",
+        PARALLEL_FLAC_TEST_DIRECTORY"/truncated.flac"
+    };
+    ma_bool32 hasError = MA_FALSE;
+    size_t iFile;
+
+    (void)argc;
+    (void)argv;
+
+    if (test_resource_manager__create_directory(PARALLEL_FLAC_TEST_DIRECTORY) != MA_SUCCESS ||
+        test_parallel_flac__write(pFilePaths[0], 441000, 4096, MA_TRUE,  MA_FALSE, MA_FALSE) != MA_SUCCESS ||
+        test_parallel_flac__write(pFilePaths[1], 300007, 1152, MA_TRUE,  MA_FALSE, MA_FALSE) != MA_SUCCESS ||
+        test_parallel_flac__write(pFilePaths[2], 300000, 4096, MA_FALSE, MA_FALSE, MA_FALSE) != MA_SUCCESS ||
+        test_parallel_flac__write(pFilePaths[3], 300000, 4096, MA_TRUE,  MA_TRUE,  MA_FALSE) != MA_SUCCESS ||
+        test_parallel_flac__write(pFilePaths[4], 100000, 4096, MA_TRUE,  MA_FALSE, MA_FALSE) != MA_SUCCESS ||
+        test_parallel_flac__write(pFilePaths[5], 441000, 4096, MA_TRUE,  MA_FALSE, MA_TRUE)  != MA_SUCCESS) {
+        printf("    Failed to generate test files.\n");
+        return -1;
+    }
+
+    for (iFile = 0; iFile < ma_countof(pFilePaths); iFile += 1) {
+        printf("    %s\n", pFilePaths[iFile]);
+
+        if (test_parallel_flac__compare(pFilePaths[iFile], ma_format_s16, 0, 0, 4) != MA_SUCCESS) {
+            hasError = MA_TRUE;
+        }
+
+        /* Channel conversion. */
+        if (test_parallel_flac__compare(pFilePaths[iFile], ma_format_f32, 1, 0, 3) != MA_SUCCESS) {
+            hasError = MA_TRUE;
+        }
+
+        /* More threads than there are ranges. */
+        if (test_parallel_flac__compare(pFilePaths[iFile], ma_format_s32, 0, 0, 16) != MA_SUCCESS) {
+            hasError = MA_TRUE;
+        }
+
+        /* Resampling always decodes on one thread. */
+        if (test_parallel_flac__compare(pFilePaths[iFile], ma_format_f32, 0, 48000, 4) != MA_SUCCESS) {
+            hasError = MA_TRUE;
+        }
+
+        if (test_parallel_flac__compare(pFilePaths[iFile], ma_format_f32, 0, 0, 1) != MA_SUCCESS) {
+            hasError = MA_TRUE;
+        }
+    }
+
+    if (hasError) {
+        return -1;
+    }
+
+    return 0;
+}
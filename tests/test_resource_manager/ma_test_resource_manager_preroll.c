@@ -0,0 +1,285 @@
+/* The hand over from the preroll to the decoder is where a gap or a repeated frame would show up, so every read is compared exactly. */
+#define PREROLL_TEST_DIRECTORY  TEST_OUTPUT_DIR"/preroll"
+#define PREROLL_TEST_F32_PATH   PREROLL_TEST_DIRECTORY"/f32.wav"
+#define PREROLL_TEST_S16_PATH   PREROLL_TEST_DIRECTORY"/s16.wav"
+
+/* Reads frameCount frames in chunks of chunkSize, waiting whenever the stream isn't ready. Returns the number of frames read. */
+static ma_uint64 test_preroll__read(ma_resource_manager_data_stream* pDataStream, float* pFrames, ma_uint64 frameCount, ma_uint32 channels, ma_uint32 chunkSize)
+{
+    ma_uint64 totalFramesRead = 0;
+    ma_uint32 retryCount = 0;
+
+    while (totalFramesRead < frameCount && retryCount < 100000) {
+        ma_result result;
+        ma_uint64 framesToRead = frameCount - totalFramesRead;
+        ma_uint64 framesRead = 0;
+
+        if (framesToRead > chunkSize) {
+            framesToRead = chunkSize;
+        }
+
+        result = ma_resource_manager_data_stream_read_pcm_frames(pDataStream, pFrames + totalFramesRead*channels, framesToRead, &framesRead);
+        totalFramesRead += framesRead;
+
+        if (result == MA_BUSY || (result == MA_INVALID_OPERATION && ma_resource_manager_data_stream_result(pDataStream) == MA_BUSY)) {
+            test_resource_manager__pump(pDataStream->pResourceManager);
+            retryCount += 1;
+            continue;
+        }
+
+        if (result != MA_SUCCESS) {
+            break;
+        }
+    }
+
+    return totalFramesRead;
+}
+
+static ma_bool32 test_preroll__is_same(const float* pFrames, const float* pExpectedFrames, ma_uint64 frameCount, ma_uint32 channels)
+{
+    return memcmp(pFrames, pExpectedFrames, (size_t)(frameCount * channels * sizeof(float))) == 0;
+}
+
+static ma_result test_preroll__run(const char* pFilePath, ma_uint32 prerollInMilliseconds, ma_uint32 jobThreadCount, ma_uint32 sampleRate)
+{
+    ma_result result;
+    ma_resource_manager_config resourceManagerConfig;
+    ma_resource_manager resourceManager;
+    ma_resource_manager_data_source_config dataSourceConfig;
+    ma_resource_manager_data_stream dataStream;
+    float* pExpectedFrames;
+    float* pFrames = NULL;
+    ma_uint64 length;
+    ma_uint64 streamLength;
+    ma_uint64 availableFrames;
+    ma_uint64 framesRead;
+    ma_uint64 prerollFrameCount;
+    ma_uint64 baselineMemoryUsage;
+    ma_uint64 registeredMemoryUsage;
+    ma_uint64 seekTarget;
+    ma_uint32 channels;
+    const char* pErrorMessage = NULL;
+
+    printf("    %s, %u ms, %u job threads, %u Hz\n", pFilePath, prerollInMilliseconds, jobThreadCount, sampleRate);
+
+    resourceManagerConfig = test_resource_manager__config_init(jobThreadCount);
+    resourceManagerConfig.decodedSampleRate = sampleRate;
+
+    result = ma_resource_manager_init(&resourceManagerConfig, &resourceManager);
+    if (result != MA_SUCCESS) {
+        return result;
+    }
+
+    result = test_resource_manager__decode_file(pFilePath, sampleRate, &pExpectedFrames, &length, &channels);
+    if (result != MA_SUCCESS) {
+        ma_resource_manager_uninit(&resourceManager);
+        return result;
+    }
+
+    /* Room for looping twice and a bit. */
+    pFrames = (float*)ma_malloc((size_t)(length * 3 * channels * sizeof(float)), NULL);
+    if (pFrames == NULL) {
+        ma_free(pExpectedFrames, NULL);
+        ma_resource_manager_uninit(&resourceManager);
+        return MA_OUT_OF_MEMORY;
+    }
+
+    /* Registering twice holds two references to the same preroll. */
+    baselineMemoryUsage = ma_resource_manager_get_memory_usage_in_bytes(&resourceManager);
+    if (ma_resource_manager_register_stream_preroll(&resourceManager, pFilePath, prerollInMilliseconds) != MA_SUCCESS ||
+        ma_resource_manager_register_stream_preroll(&resourceManager, pFilePath, prerollInMilliseconds) != MA_SUCCESS) {
+        pErrorMessage = "Failed to register the preroll.";
+        goto done;
+    }
+
+    registeredMemoryUsage = ma_resource_manager_get_memory_usage_in_bytes(&resourceManager);
+    if (registeredMemoryUsage <= baselineMemoryUsage) {
+        pErrorMessage = "The preroll is not counted in the memory usage.";
+        goto done;
+    }
+
+    /* A synchronous stream still waits for its decoder, and must play the whole file without a discontinuity at the end of the preroll. */
+    if (ma_resource_manager_data_stream_init(&resourceManager, pFilePath, 0, NULL, &dataStream) != MA_SUCCESS) {
+        pErrorMessage = "Failed to initialize a synchronous stream.";
+        goto done;
+    }
+
+    if (ma_resource_manager_data_stream_result(&dataStream) != MA_SUCCESS) {
+        pErrorMessage = "A synchronous stream was not ready after initialization.";
+        ma_resource_manager_data_stream_uninit(&dataStream);
+        goto done;
+    }
+
+    framesRead = test_preroll__read(&dataStream, pFrames, length, channels, 1000);
+    ma_resource_manager_data_stream_uninit(&dataStream);
+
+    if (framesRead != length || !test_preroll__is_same(pFrames, pExpectedFrames, length, channels)) {
+        pErrorMessage = "A synchronous stream did not match the decoder.";
+        goto done;
+    }
+
+    /* An asynchronous stream knows its length straight away and can be read from the preroll immediately. The length can be a frame off when resampling. */
+    if (ma_resource_manager_data_stream_init(&resourceManager, pFilePath, MA_RESOURCE_MANAGER_DATA_SOURCE_FLAG_ASYNC, NULL, &dataStream) != MA_SUCCESS) {
+        pErrorMessage = "Failed to initialize an asynchronous stream.";
+        goto done;
+    }
+
+    prerollFrameCount = (dataStream.pPreroll != NULL) ? dataStream.pPreroll->frameCount : 0;
+    if (prerollFrameCount == 0 || prerollFrameCount > length ||
+        ma_resource_manager_data_stream_get_length_in_pcm_frames(&dataStream, &streamLength) != MA_SUCCESS || (sampleRate == 0 && streamLength != length) ||
+        ma_resource_manager_data_stream_get_available_frames(&dataStream, &availableFrames) != MA_SUCCESS || availableFrames < prerollFrameCount) {
+        pErrorMessage = "An asynchronous stream did not start with the preroll.";
+        ma_resource_manager_data_stream_uninit(&dataStream);
+        goto done;
+    }
+
+    if (ma_resource_manager_data_stream_read_pcm_frames(&dataStream, pFrames, ma_min(100, prerollFrameCount), &framesRead) != MA_SUCCESS || framesRead != ma_min(100, prerollFrameCount) ||
+        !test_preroll__is_same(pFrames, pExpectedFrames, framesRead, channels)) {
+        pErrorMessage = "Reading the preroll straight after initialization failed.";
+        ma_resource_manager_data_stream_uninit(&dataStream);
+        goto done;
+    }
+
+    /* Back to the start while still in the preroll, then all the way through in odd sized chunks. */
+    ma_resource_manager_data_stream_seek_to_pcm_frame(&dataStream, 0);
+    framesRead = test_preroll__read(&dataStream, pFrames, length, channels, 777);
+    if (framesRead != length || !test_preroll__is_same(pFrames, pExpectedFrames, length, channels)) {
+        pErrorMessage = "An asynchronous stream did not match the decoder.";
+        ma_resource_manager_data_stream_uninit(&dataStream);
+        goto done;
+    }
+
+    /* Seeking back into the preroll after the decoder has moved on. */
+    ma_resource_manager_data_stream_seek_to_pcm_frame(&dataStream, 10);
+    framesRead = test_preroll__read(&dataStream, pFrames, length - 10, channels, 1000);
+    if (framesRead != length - 10 || !test_preroll__is_same(pFrames, pExpectedFrames + 10*channels, length - 10, channels)) {
+        pErrorMessage = "Seeking back into the preroll gave the wrong audio.";
+        ma_resource_manager_data_stream_uninit(&dataStream);
+        goto done;
+    }
+
+    /* Seeking past the preroll. Seeking isn't sample exact when resampling so the audio is only compared without it. */
+    seekTarget = length/2 + 3;
+    ma_resource_manager_data_stream_seek_to_pcm_frame(&dataStream, seekTarget);
+    framesRead = test_preroll__read(&dataStream, pFrames, length, channels, 1000);
+    if (sampleRate == 0 && (framesRead != length - seekTarget || !test_preroll__is_same(pFrames, pExpectedFrames + seekTarget*channels, framesRead, channels))) {
+        pErrorMessage = "Seeking past the preroll gave the wrong audio.";
+        ma_resource_manager_data_stream_uninit(&dataStream);
+        goto done;
+    }
+
+    ma_resource_manager_data_stream_uninit(&dataStream);
+
+    /* Dropping one of the two references keeps the preroll registered. */
+    ma_resource_manager_unregister_stream_preroll(&resourceManager, pFilePath);
+
+    dataSourceConfig = ma_resource_manager_data_source_config_init();
+    dataSourceConfig.pFilePath = pFilePath;
+    dataSourceConfig.flags     = MA_RESOURCE_MANAGER_DATA_SOURCE_FLAG_ASYNC;
+    dataSourceConfig.isLooping = MA_TRUE;
+
+    if (ma_resource_manager_data_stream_init_ex(&resourceManager, &dataSourceConfig, &dataStream) != MA_SUCCESS) {
+        pErrorMessage = "Failed to initialize a looping stream.";
+        goto done;
+    }
+
+    /* Looping isn't sample exact when resampling either, so only the first pass is compared in that case. */
+    framesRead = test_preroll__read(&dataStream, pFrames, length*2 + 123, channels, 1024);
+    if (framesRead != length*2 + 123 || !test_preroll__is_same(pFrames, pExpectedFrames, length, channels) ||
+        (sampleRate == 0 && (!test_preroll__is_same(pFrames + length*channels, pExpectedFrames, length, channels) || !test_preroll__is_same(pFrames + length*2*channels, pExpectedFrames, 123, channels)))) {
+        pErrorMessage = "A looping stream did not loop back through the preroll correctly.";
+        ma_resource_manager_data_stream_uninit(&dataStream);
+        goto done;
+    }
+
+    /* Unregistering while a stream is still using the preroll must leave the stream's copy alone until the stream is done with it. */
+    if (ma_resource_manager_unregister_stream_preroll(&resourceManager, pFilePath) != MA_SUCCESS ||
+        ma_resource_manager_unregister_stream_preroll(&resourceManager, pFilePath) != MA_DOES_NOT_EXIST ||
+        ma_resource_manager_get_memory_usage_in_bytes(&resourceManager) != registeredMemoryUsage) {
+        pErrorMessage = "Unregistering a preroll in use failed.";
+        ma_resource_manager_data_stream_uninit(&dataStream);
+        goto done;
+    }
+
+    ma_resource_manager_data_stream_seek_to_pcm_frame(&dataStream, 0);
+    framesRead = test_preroll__read(&dataStream, pFrames, 64, channels, 64);
+    ma_resource_manager_data_stream_uninit(&dataStream);
+
+    if (framesRead != 64 || !test_preroll__is_same(pFrames, pExpectedFrames, 64, channels)) {
+        pErrorMessage = "A stream could not seek back into an unregistered preroll.";
+        goto done;
+    }
+
+    if (ma_resource_manager_get_memory_usage_in_bytes(&resourceManager) != baselineMemoryUsage) {
+        pErrorMessage = "The preroll was not freed when its last stream was uninitialized.";
+        goto done;
+    }
+
+    /* Missing files can't be prerolled. Anything still registered is freed by ma_resource_manager_uninit(). */
+    if (ma_resource_manager_register_stream_preroll(&resourceManager, PREROLL_TEST_DIRECTORY"/missing.wav", 0) == MA_SUCCESS ||
+        ma_resource_manager_register_stream_preroll(&resourceManager, pFilePath, 0) != MA_SUCCESS) {
+        pErrorMessage = "Registering a preroll for a missing file did not fail.";
+        goto done;
+    }
+
+done:
+    ma_resource_manager_uninit(&resourceManager);
+    ma_free(pFrames, NULL);
+    ma_free(pExpectedFrames, NULL);
+
+    return test_resource_manager__report(pErrorMessage);
+}
+
+int test_entry__resource_manager_preroll(int argc, char** argv)
+{
+    ma_bool32 hasError = MA_FALSE;
+
+    (void)argc;
+    (void)argv;
+
+    if (test_resource_manager__create_directory(PREROLL_TEST_DIRECTORY) != MA_SUCCESS ||
+        test_resource_manager__write_wav(PREROLL_TEST_F32_PATH, ma_format_f32, 2, 48000, 48000*3) != MA_SUCCESS ||
+        test_resource_manager__write_wav(PREROLL_TEST_S16_PATH, ma_format_s16, 1, 44100, 44100) != MA_SUCCESS) {
+        printf("    Failed to generate test files.\n");
+        return -1;
+    }
+
+    if (test_preroll__run(PREROLL_TEST_F32_PATH,  300, 1, 0) != MA_SUCCESS) {
+        hasError = MA_TRUE;
+    }
+
+    if (test_preroll__run(PREROLL_TEST_F32_PATH,  300, 1, 44100) != MA_SUCCESS) {
+        hasError = MA_TRUE;
+    }
+
+    if (test_preroll__run(PREROLL_TEST_S16_PATH,   50, 3, 0) != MA_SUCCESS) {
+        hasError = MA_TRUE;
+    }
+
+    if (test_preroll__run(PREROLL_TEST_S16_PATH,   50, 2, 22050) != MA_SUCCESS) {
+        hasError = MA_TRUE;
+    }
+
+    /* Longer than the file. */
+    if (test_preroll__run(PREROLL_TEST_S16_PATH, 5000, 1, 0) != MA_SUCCESS) {
+        hasError = MA_TRUE;
+    }
+
+    if (test_preroll__run(PREROLL_TEST_F32_PATH,  300, 0, 0) != MA_SUCCESS) {
+        hasError = MA_TRUE;
+    }
+
+    if (test_preroll__run(PREROLL_TEST_S16_PATH,   50, 0, 32000) != MA_SUCCESS) {
+        hasError = MA_TRUE;
+    }
+
+    if (test_preroll__run(PREROLL_TEST_S16_PATH, 5000, 0, 0) != MA_SUCCESS) {
+        hasError = MA_TRUE;
+    }
+
+    if (hasError) {
+        return -1;
+    }
+
+    return 0;
+}
@@ -0,0 +1,345 @@
+/*
+Whether a seek table was used is told apart by how much of the file was read. Without one the decoder has to scan the whole thing to
+find out its length.
+*/
+#define SEEK_TABLE_TEST_DIRECTORY       TEST_OUTPUT_DIR"/seek_table"
+#define SEEK_TABLE_TEST_CACHE_DIRECTORY SEEK_TABLE_TEST_DIRECTORY"/cache"
+#define SEEK_TABLE_TEST_PATH            SEEK_TABLE_TEST_DIRECTORY"/test.mp3"
+#define SEEK_TABLE_TEST_MP3_FRAME_COUNT 2000
+#define SEEK_TABLE_TEST_SEEK_POINTS     32
+
+/* Counts the bytes read from files so we can tell whether the whole file was scanned. */
+typedef struct
+{
+    ma_default_vfs base;
+    ma_uint64 bytesRead;
+} test_seek_table_counting_vfs;
+
+static ma_result (* g_test_seek_table_onRead)(ma_vfs* pVFS, ma_vfs_file file, void* pDst, size_t sizeInBytes, size_t* pBytesRead);
+
+static ma_result test_seek_table__counting_vfs_read(ma_vfs* pVFS, ma_vfs_file file, void* pDst, size_t sizeInBytes, size_t* pBytesRead)
+{
+    ma_result result = g_test_seek_table_onRead(pVFS, file, pDst, sizeInBytes, pBytesRead);
+    ((test_seek_table_counting_vfs*)pVFS)->bytesRead += *pBytesRead;
+    return result;
+}
+
+static ma_result test_seek_table__counting_vfs_init(test_seek_table_counting_vfs* pVFS)
+{
+    ma_result result;
+
+    result = ma_default_vfs_init(&pVFS->base, NULL);
+    if (result != MA_SUCCESS) {
+        return result;
+    }
+
+    g_test_seek_table_onRead = pVFS->base.cb.onRead;
+    pVFS->base.cb.onRead = test_seek_table__counting_vfs_read;
+    pVFS->bytesRead = 0;
+
+    return MA_SUCCESS;
+}
+
+static ma_bool32 test_seek_table__read_at(ma_decoder* pDecoder, ma_uint64 frameIndex, float* pFrames, ma_uint64 frameCount)
+{
+    ma_uint64 framesRead;
+
+    if (ma_decoder_seek_to_pcm_frame(pDecoder, frameIndex) != MA_SUCCESS) {
+        return MA_FALSE;
+    }
+
+    return ma_decoder_read_pcm_frames(pDecoder, pFrames, frameCount, &framesRead) == MA_SUCCESS && framesRead == frameCount;
+}
+
+static ma_result test_seek_table__decoder(test_seek_table_counting_vfs* pVFS, ma_uint64 fileSizeInBytes)
+{
+    ma_result result = MA_ERROR;
+    ma_decoder_config decoderConfig;
+    ma_decoder generated;
+    ma_decoder imported;
+    void* pSeekTableData = NULL;
+    void* pImportedSeekTableData = NULL;
+    size_t seekTableDataSize;
+    size_t dataSize;
+    ma_uint64 generatedLength;
+    ma_uint64 importedLength;
+    ma_uint64 frameIndices[5];
+    float generatedFrames[1024];
+    float importedFrames[1024];
+    ma_uint32 iSeek;
+
+    decoderConfig = ma_decoder_config_init(ma_format_f32, 0, 0);
+    decoderConfig.seekPointCount = SEEK_TABLE_TEST_SEEK_POINTS;
+
+    if (ma_decoder_init_vfs(pVFS, SEEK_TABLE_TEST_PATH, &decoderConfig, &generated) != MA_SUCCESS) {
+        printf("    Failed to open the test file.\n");
+        return MA_ERROR;
+    }
+
+    ma_decoder_get_length_in_pcm_frames(&generated, &generatedLength);
+
+    if (ma_decoder_get_seek_table_data(&generated, NULL, 0, &seekTableDataSize) != MA_SUCCESS || seekTableDataSize == 0) {
+        printf("    Failed to retrieve the size of the seek table.\n");
+        goto done;
+    }
+
+    pSeekTableData         = ma_malloc(seekTableDataSize, NULL);
+    pImportedSeekTableData = ma_malloc(seekTableDataSize, NULL);
+    if (pSeekTableData == NULL || pImportedSeekTableData == NULL) {
+        goto done;
+    }
+
+    if (ma_decoder_get_seek_table_data(&generated, pSeekTableData, seekTableDataSize - 1, &dataSize) != MA_NO_SPACE ||
+        ma_decoder_get_seek_table_data(&generated, pSeekTableData, seekTableDataSize, &dataSize) != MA_SUCCESS || dataSize != seekTableDataSize) {
+        printf("    Failed to export the seek table.\n");
+        goto done;
+    }
+
+    /* Opening with the table and asking for the length must not read the whole file. */
+    decoderConfig.pSeekTableData           = pSeekTableData;
+    decoderConfig.seekTableDataSizeInBytes = seekTableDataSize;
+
+    pVFS->bytesRead = 0;
+    if (ma_decoder_init_vfs(pVFS, SEEK_TABLE_TEST_PATH, &decoderConfig, &imported) != MA_SUCCESS) {
+        printf("    Failed to open the test file with a seek table.\n");
+        goto done;
+    }
+
+    ma_decoder_get_length_in_pcm_frames(&imported, &importedLength);
+
+    if (pVFS->bytesRead >= fileSizeInBytes / 4 || importedLength != generatedLength) {
+        printf("    Opening with a seek table read %u bytes of %u, length %u vs %u.\n", (ma_uint32)pVFS->bytesRead, (ma_uint32)fileSizeInBytes, (ma_uint32)importedLength, (ma_uint32)generatedLength);
+        ma_decoder_uninit(&imported);
+        goto done;
+    }
+
+    if (ma_decoder_get_seek_table_data(&imported, pImportedSeekTableData, seekTableDataSize, &dataSize) != MA_SUCCESS || dataSize != seekTableDataSize || memcmp(pImportedSeekTableData, pSeekTableData, seekTableDataSize) != 0) {
+        printf("    The imported seek table is different to the exported one.\n");
+        ma_decoder_uninit(&imported);
+        goto done;
+    }
+
+    frameIndices[0] = 0;
+    frameIndices[1] = 3;
+    frameIndices[2] = generatedLength / 2;
+    frameIndices[3] = 12345;
+    frameIndices[4] = generatedLength - 1024;
+
+    for (iSeek = 0; iSeek < ma_countof(frameIndices); iSeek += 1) {
+        if (!test_seek_table__read_at(&generated, frameIndices[iSeek], generatedFrames, 1024) ||
+            !test_seek_table__read_at(&imported,  frameIndices[iSeek], importedFrames,  1024) ||
+            memcmp(generatedFrames, importedFrames, sizeof(generatedFrames)) != 0) {
+            printf("    Seeking to %u with the imported table gave different audio.\n", (ma_uint32)frameIndices[iSeek]);
+            ma_decoder_uninit(&imported);
+            goto done;
+        }
+    }
+
+    ma_decoder_uninit(&imported);
+
+    /* Tables with the wrong version or that are truncated are ignored, and a new one is generated by scanning the file. */
+    ((ma_uint8*)pSeekTableData)[4] += 1;
+    pVFS->bytesRead = 0;
+    if (ma_decoder_init_vfs(pVFS, SEEK_TABLE_TEST_PATH, &decoderConfig, &imported) != MA_SUCCESS || pVFS->bytesRead < fileSizeInBytes) {
+        printf("    A seek table with the wrong version was not ignored.\n");
+        goto done;
+    }
+    ma_decoder_uninit(&imported);
+
+    ((ma_uint8*)pSeekTableData)[4] -= 1;
+    decoderConfig.seekTableDataSizeInBytes = seekTableDataSize - 1;
+    pVFS->bytesRead = 0;
+    if (ma_decoder_init_vfs(pVFS, SEEK_TABLE_TEST_PATH, &decoderConfig, &imported) != MA_SUCCESS || pVFS->bytesRead < fileSizeInBytes) {
+        printf("    A truncated seek table was not ignored.\n");
+        goto done;
+    }
+    ma_decoder_uninit(&imported);
+
+    result = MA_SUCCESS;
+
+done:
+    ma_free(pSeekTableData, NULL);
+    ma_free(pImportedSeekTableData, NULL);
+    ma_decoder_uninit(&generated);
+    return result;
+}
+
+/* Opens the test file as a stream, checks the length, seeks near the end and returns the number of bytes that were read. */
+static ma_result test_seek_table__open_stream(ma_resource_manager* pResourceManager, test_seek_table_counting_vfs* pVFS, ma_uint64 expectedLength, ma_uint64* pBytesRead)
+{
+    ma_result result;
+    ma_resource_manager_data_source dataSource;
+    ma_uint64 length;
+
+    pVFS->bytesRead = 0;
+
+    result = ma_resource_manager_data_source_init(pResourceManager, SEEK_TABLE_TEST_PATH, MA_RESOURCE_MANAGER_DATA_SOURCE_FLAG_STREAM | MA_RESOURCE_MANAGER_DATA_SOURCE_FLAG_WAIT_INIT, NULL, &dataSource);
+    if (result != MA_SUCCESS) {
+        return result;
+    }
+
+    result = ma_resource_manager_data_source_get_length_in_pcm_frames(&dataSource, &length);
+    if (result == MA_SUCCESS && length != expectedLength) {
+        printf("    Stream length is %u, expecting %u.\n", (ma_uint32)length, (ma_uint32)expectedLength);
+        result = MA_ERROR;
+    }
+
+    if (result == MA_SUCCESS) {
+        result = ma_resource_manager_data_source_seek_to_pcm_frame(&dataSource, expectedLength - 10000);
+    }
+
+    ma_resource_manager_data_source_uninit(&dataSource);
+
+    *pBytesRead = pVFS->bytesRead;
+
+    return result;
+}
+
+static ma_result test_seek_table__resource_manager(test_seek_table_counting_vfs* pVFS, ma_uint64 fileSizeInBytes, ma_uint64 length, const char* pCacheDirectory)
+{
+    ma_result result;
+    ma_resource_manager_config resourceManagerConfig;
+    ma_resource_manager resourceManager;
+    ma_uint64 bytesRead;
+    ma_uint32 iOpen;
+
+    resourceManagerConfig = test_resource_manager__config_init(1);
+    resourceManagerConfig.pVFS                   = pVFS;
+    resourceManagerConfig.seekPointCount         = SEEK_TABLE_TEST_SEEK_POINTS;
+    resourceManagerConfig.pDecodedCacheDirectory = pCacheDirectory;
+
+    result = ma_resource_manager_init(&resourceManagerConfig, &resourceManager);
+    if (result != MA_SUCCESS) {
+        return result;
+    }
+
+    /* The first open scans the file unless the table was saved to the cache directory by an earlier resource manager. */
+    for (iOpen = 0; iOpen < 2; iOpen += 1) {
+        result = test_seek_table__open_stream(&resourceManager, pVFS, length, &bytesRead);
+        if (result != MA_SUCCESS) {
+            break;
+        }
+
+        if (iOpen > 0 && bytesRead >= fileSizeInBytes / 2) {
+            printf("    Reopening a stream read %u bytes of %u.\n", (ma_uint32)bytesRead, (ma_uint32)fileSizeInBytes);
+            result = MA_ERROR;
+            break;
+        }
+    }
+
+    ma_resource_manager_uninit(&resourceManager);
+
+    return result;
+}
+
+static ma_result test_seek_table__resource_manager_saved(test_seek_table_counting_vfs* pVFS, ma_uint64 fileSizeInBytes, ma_uint64 length)
+{
+    ma_result result;
+    ma_resource_manager_config resourceManagerConfig;
+    ma_resource_manager resourceManager;
+    ma_uint64 bytesRead;
+
+    resourceManagerConfig = test_resource_manager__config_init(1);
+    resourceManagerConfig.pVFS                   = pVFS;
+    resourceManagerConfig.seekPointCount         = SEEK_TABLE_TEST_SEEK_POINTS;
+    resourceManagerConfig.pDecodedCacheDirectory = SEEK_TABLE_TEST_CACHE_DIRECTORY;
+
+    result = ma_resource_manager_init(&resourceManagerConfig, &resourceManager);
+    if (result != MA_SUCCESS) {
+        return result;
+    }
+
+    result = test_seek_table__open_stream(&resourceManager, pVFS, length, &bytesRead);
+    if (result == MA_SUCCESS && bytesRead >= fileSizeInBytes / 2) {
+        printf("    The seek table was not loaded from the cache directory. Read %u bytes of %u.\n", (ma_uint32)bytesRead, (ma_uint32)fileSizeInBytes);
+        result = MA_ERROR;
+    }
+
+    ma_resource_manager_uninit(&resourceManager);
+
+    return result;
+}
+
+static ma_result test_seek_table__get_file_info(ma_uint64* pFileSizeInBytes, ma_uint64* pLength)
+{
+    ma_result result;
+    ma_decoder_config decoderConfig;
+    ma_decoder decoder;
+    FILE* pFile;
+
+    pFile = fopen(SEEK_TABLE_TEST_PATH, "rb");
+    if (pFile == NULL) {
+        return MA_IO_ERROR;
+    }
+
+    fseek(pFile, 0, SEEK_END);
+    *pFileSizeInBytes = (ma_uint64)ftell(pFile);
+    fclose(pFile);
+
+    decoderConfig = ma_decoder_config_init(ma_format_f32, 0, 0);
+    result = ma_decoder_init_file(SEEK_TABLE_TEST_PATH, &decoderConfig, &decoder);
+    if (result != MA_SUCCESS) {
+        return result;
+    }
+
+    result = ma_decoder_get_length_in_pcm_frames(&decoder, pLength);
+    ma_decoder_uninit(&decoder);
+
+    return result;
+}
+
+int test_entry__resource_manager_seek_table(int argc, char** argv)
+{
+    ma_bool32 hasError = MA_FALSE;
+    test_seek_table_counting_vfs vfs;
+    ma_uint64 fileSizeInBytes;
+    ma_uint64 length;
+
+    (void)argc;
+    (void)argv;
+
+    if (test_resource_manager__create_directory(SEEK_TABLE_TEST_DIRECTORY) != MA_SUCCESS ||
+        test_resource_manager__create_directory(SEEK_TABLE_TEST_CACHE_DIRECTORY) != MA_SUCCESS ||
+        test_resource_manager__write_mp3(SEEK_TABLE_TEST_PATH, SEEK_TABLE_TEST_MP3_FRAME_COUNT) != MA_SUCCESS ||
+        test_seek_table__get_file_info(&fileSizeInBytes, &length) != MA_SUCCESS) {
+        printf("    Failed to generate the test file.\n");
+        return -1;
+    }
+
+    if (test_seek_table__counting_vfs_init(&vfs) != MA_SUCCESS) {
+        return -1;
+    }
+
+    if (test_seek_table__decoder(&vfs, fileSizeInBytes) != MA_SUCCESS) {
+        hasError = MA_TRUE;
+    }
+
+    /* Remembered in memory only. */
+    if (test_seek_table__resource_manager(&vfs, fileSizeInBytes, length, NULL) != MA_SUCCESS) {
+        hasError = MA_TRUE;
+    }
+
+    /* Saved to the cache directory and picked up by a new resource manager. */
+    if (test_seek_table__resource_manager(&vfs, fileSizeInBytes, length, SEEK_TABLE_TEST_CACHE_DIRECTORY) != MA_SUCCESS ||
+        test_seek_table__resource_manager_saved(&vfs, fileSizeInBytes, length) != MA_SUCCESS) {
+        hasError = MA_TRUE;
+    }
+
+    /* A saved table must not be used for a file that has changed since. The stream would report the old length if it was. */
+    if (test_resource_manager__write_mp3(SEEK_TABLE_TEST_PATH, SEEK_TABLE_TEST_MP3_FRAME_COUNT / 2) != MA_SUCCESS ||
+        test_seek_table__get_file_info(&fileSizeInBytes, &length) != MA_SUCCESS) {
+        printf("    Failed to modify the test file.\n");
+        return -1;
+    }
+
+    if (test_seek_table__resource_manager(&vfs, fileSizeInBytes, length, SEEK_TABLE_TEST_CACHE_DIRECTORY) != MA_SUCCESS) {
+        printf("    A changed file was opened with its old seek table.\n");
+        hasError = MA_TRUE;
+    }
+
+    if (hasError) {
+        return -1;
+    }
+
+    return 0;
+}
@@ -0,0 +1,251 @@
+/* Misnamed files are copies of correctly named ones, which are what they're compared against. */
+#define SNIFFING_TEST_DIRECTORY TEST_OUTPUT_DIR"/sniffing"
+#define SNIFFING_TEST_WAV_PATH  SNIFFING_TEST_DIRECTORY"/test.wav"
+#define SNIFFING_TEST_MP3_PATH  SNIFFING_TEST_DIRECTORY"/test.mp3"
+#define SNIFFING_TEST_ID3_SIZE  256
+
+/* Copies a file, optionally putting an ID3v2 tag made up of nothing but padding in front of it. */
+static ma_result test_sniffing__copy_file(const char* pSrcFilePath, const char* pDstFilePath, ma_bool32 addID3Tag)
+{
+    ma_result result;
+    void* pData;
+    size_t dataSize;
+    FILE* pFile;
+
+    result = ma_vfs_open_and_read_file(NULL, pSrcFilePath, &pData, &dataSize, NULL);
+    if (result != MA_SUCCESS) {
+        return result;
+    }
+
+    result = ma_fopen(&pFile, pDstFilePath, "wb");
+    if (result != MA_SUCCESS) {
+        ma_free(pData, NULL);
+        return result;
+    }
+
+    if (addID3Tag) {
+        ma_uint8 tag[10 + SNIFFING_TEST_ID3_SIZE];
+
+        MA_ZERO_MEMORY(tag, sizeof(tag));
+
+        /* ID3v2.4 with no flags. The size is a 28 bit syncsafe integer that doesn't include the 10 byte header. */
+        tag[0] = 'I';
+        tag[1] = 'D';
+        tag[2] = '3';
+        tag[3] = 4;
+        tag[8] = (ma_uint8)((SNIFFING_TEST_ID3_SIZE >> 7) & 0x7F);
+        tag[9] = (ma_uint8)( SNIFFING_TEST_ID3_SIZE       & 0x7F);
+
+        if (fwrite(tag, 1, sizeof(tag), pFile) != sizeof(tag)) {
+            result = MA_IO_ERROR;
+        }
+    }
+
+    if (result == MA_SUCCESS && fwrite(pData, 1, dataSize, pFile) != dataSize) {
+        result = MA_IO_ERROR;
+    }
+
+    fclose(pFile);
+    ma_free(pData, NULL);
+
+    return result;
+}
+
+static ma_result test_sniffing__check(const char* pFilePath, const char* pReferenceFilePath, ma_encoding_format expectedHeaderEncodingFormat)
+{
+    ma_result result;
+    ma_decoder_config decoderConfig;
+    ma_decoder decoder;
+    ma_default_vfs vfs;
+    ma_resource_manager_config resourceManagerConfig;
+    ma_resource_manager resourceManager;
+    ma_resource_manager_data_source dataSource;
+    void* pData;
+    size_t dataSize;
+    float* pExpectedFrames;
+    float* pFrames;
+    ma_uint64 expectedLength;
+    ma_uint64 length;
+    ma_uint64 framesRead;
+    ma_uint32 channels;
+
+    printf("    %s\n", pFilePath);
+
+    result = test_resource_manager__decode_file(pReferenceFilePath, 0, &pExpectedFrames, &expectedLength, &channels);
+    if (result != MA_SUCCESS) {
+        return result;
+    }
+
+    decoderConfig = ma_decoder_config_init(ma_format_f32, 0, 0);
+
+    /* From a file. */
+    length = 0;
+    if (ma_decoder_init_file(pFilePath, &decoderConfig, &decoder) == MA_SUCCESS) {
+        ma_decoder_get_length_in_pcm_frames(&decoder, &length);
+        ma_decoder_uninit(&decoder);
+    }
+
+    if (length != expectedLength) {
+        printf("    Failed to open from a file.\n");
+        ma_free(pExpectedFrames, NULL);
+        return MA_ERROR;
+    }
+
+    /* From a VFS. */
+    length = 0;
+    ma_default_vfs_init(&vfs, NULL);
+    if (ma_decoder_init_vfs(&vfs, pFilePath, &decoderConfig, &decoder) == MA_SUCCESS) {
+        ma_decoder_get_length_in_pcm_frames(&decoder, &length);
+        ma_decoder_uninit(&decoder);
+    }
+
+    if (length != expectedLength) {
+        printf("    Failed to open from a VFS.\n");
+        ma_free(pExpectedFrames, NULL);
+        return MA_ERROR;
+    }
+
+    /* From memory, where there's no file name to go on at all. */
+    result = ma_vfs_open_and_read_file(NULL, pFilePath, &pData, &dataSize, NULL);
+    if (result != MA_SUCCESS) {
+        ma_free(pExpectedFrames, NULL);
+        return result;
+    }
+
+    length = 0;
+    if (ma_decoder_init_memory(pData, dataSize, &decoderConfig, &decoder) == MA_SUCCESS) {
+        ma_decoder_get_length_in_pcm_frames(&decoder, &length);
+        ma_decoder_uninit(&decoder);
+    }
+
+    if (length != expectedLength || ma_encoding_format_from_header(pData, ma_min(dataSize, MA_DECODER_HEADER_SIZE_IN_BYTES)) != expectedHeaderEncodingFormat) {
+        printf("    Failed to open from memory, or the header was identified as the wrong format.\n");
+        ma_free(pData, NULL);
+        ma_free(pExpectedFrames, NULL);
+        return MA_ERROR;
+    }
+
+    ma_free(pData, NULL);
+
+    /* Through the resource manager. */
+    resourceManagerConfig = test_resource_manager__config_init(1);
+
+    result = ma_resource_manager_init(&resourceManagerConfig, &resourceManager);
+    if (result != MA_SUCCESS) {
+        ma_free(pExpectedFrames, NULL);
+        return result;
+    }
+
+    result = ma_resource_manager_data_source_init(&resourceManager, pFilePath, MA_RESOURCE_MANAGER_DATA_SOURCE_FLAG_DECODE, NULL, &dataSource);
+    if (result == MA_SUCCESS) {
+        pFrames = (float*)ma_malloc((size_t)(expectedLength * channels * sizeof(float)), NULL);
+        if (pFrames == NULL) {
+            result = MA_OUT_OF_MEMORY;
+        } else {
+            framesRead = test_resource_manager__read_all(&dataSource, pFrames, channels, expectedLength);
+            if (framesRead != expectedLength || memcmp(pFrames, pExpectedFrames, (size_t)(framesRead * channels * sizeof(float))) != 0) {
+                result = MA_ERROR;
+            }
+
+            ma_free(pFrames, NULL);
+        }
+
+        ma_resource_manager_data_source_uninit(&dataSource);
+    }
+
+    if (result != MA_SUCCESS) {
+        printf("    Failed to load through the resource manager.\n");
+    }
+
+    ma_resource_manager_uninit(&resourceManager);
+    ma_free(pExpectedFrames, NULL);
+
+    return result;
+}
+
+int test_entry__resource_manager_sniffing(int argc, char** argv)
+{
+    ma_bool32 hasError = MA_FALSE;
+    ma_decoder_config decoderConfig;
+    ma_decoder decoder;
+    ma_uint8 junk[100];
+
+    (void)argc;
+    (void)argv;
+
+    if (test_resource_manager__create_directory(SNIFFING_TEST_DIRECTORY) != MA_SUCCESS ||
+        test_resource_manager__write_wav(SNIFFING_TEST_WAV_PATH, ma_format_s16, 2, 44100, 10000) != MA_SUCCESS ||
+        test_resource_manager__write_mp3(SNIFFING_TEST_MP3_PATH, 50) != MA_SUCCESS ||
+        test_sniffing__copy_file(SNIFFING_TEST_WAV_PATH, SNIFFING_TEST_DIRECTORY"/wav.mp3",  MA_FALSE) != MA_SUCCESS ||
+        test_sniffing__copy_file(SNIFFING_TEST_WAV_PATH, SNIFFING_TEST_DIRECTORY"/wav.flac", MA_FALSE) != MA_SUCCESS ||
+        test_sniffing__copy_file(SNIFFING_TEST_MP3_PATH, SNIFFING_TEST_DIRECTORY"/mp3.wav",  MA_FALSE) != MA_SUCCESS ||
+        test_sniffing__copy_file(SNIFFING_TEST_MP3_PATH, SNIFFING_TEST_DIRECTORY"/mp3.bin",  MA_FALSE) != MA_SUCCESS ||
+        test_sniffing__copy_file(SNIFFING_TEST_MP3_PATH, SNIFFING_TEST_DIRECTORY"/id3.mp3",  MA_TRUE)  != MA_SUCCESS ||
+        test_sniffing__copy_file(SNIFFING_TEST_MP3_PATH, SNIFFING_TEST_DIRECTORY"/id3.wav",  MA_TRUE)  != MA_SUCCESS) {
+        printf("    Failed to generate test files.\n");
+        return -1;
+    }
+
+    if (test_sniffing__check(SNIFFING_TEST_WAV_PATH, SNIFFING_TEST_WAV_PATH, ma_encoding_format_wav) != MA_SUCCESS) {
+        hasError = MA_TRUE;
+    }
+
+    if (test_sniffing__check(SNIFFING_TEST_MP3_PATH, SNIFFING_TEST_MP3_PATH, ma_encoding_format_mp3) != MA_SUCCESS) {
+        hasError = MA_TRUE;
+    }
+
+    if (test_sniffing__check(SNIFFING_TEST_DIRECTORY"/wav.mp3", SNIFFING_TEST_WAV_PATH, ma_encoding_format_wav) != MA_SUCCESS) {
+        hasError = MA_TRUE;
+    }
+
+    if (test_sniffing__check(SNIFFING_TEST_DIRECTORY"/wav.flac", SNIFFING_TEST_WAV_PATH, ma_encoding_format_wav) != MA_SUCCESS) {
+        hasError = MA_TRUE;
+    }
+
+    if (test_sniffing__check(SNIFFING_TEST_DIRECTORY"/mp3.wav", SNIFFING_TEST_MP3_PATH, ma_encoding_format_mp3) != MA_SUCCESS) {
+        hasError = MA_TRUE;
+    }
+
+    if (test_sniffing__check(SNIFFING_TEST_DIRECTORY"/mp3.bin", SNIFFING_TEST_MP3_PATH, ma_encoding_format_mp3) != MA_SUCCESS) {
+        hasError = MA_TRUE;
+    }
+
+    /* An ID3 tag hides the format so these fall back to trial and error. */
+    if (test_sniffing__check(SNIFFING_TEST_DIRECTORY"/id3.mp3", SNIFFING_TEST_MP3_PATH, ma_encoding_format_unknown) != MA_SUCCESS) {
+        hasError = MA_TRUE;
+    }
+
+    if (test_sniffing__check(SNIFFING_TEST_DIRECTORY"/id3.wav", SNIFFING_TEST_MP3_PATH, ma_encoding_format_unknown) != MA_SUCCESS) {
+        hasError = MA_TRUE;
+    }
+
+    /* Asking for a specific format still only tries that format. */
+    decoderConfig = ma_decoder_config_init(ma_format_f32, 0, 0);
+    decoderConfig.encodingFormat = ma_encoding_format_mp3;
+    if (ma_decoder_init_file(SNIFFING_TEST_WAV_PATH, &decoderConfig, &decoder) == MA_SUCCESS) {
+        printf("    A WAV file was opened as MP3.\n");
+        ma_decoder_uninit(&decoder);
+        hasError = MA_TRUE;
+    }
+
+    /* Data that isn't audio, including data too short to hold a header, must fail rather than be handed to a backend on a guess. */
+    MA_ZERO_MEMORY(junk, sizeof(junk));
+    decoderConfig.encodingFormat = ma_encoding_format_unknown;
+    if (ma_decoder_init_memory(junk, sizeof(junk), &decoderConfig, &decoder) == MA_SUCCESS) {
+        printf("    Junk was opened as audio.\n");
+        ma_decoder_uninit(&decoder);
+        hasError = MA_TRUE;
+    }
+
+    if (ma_decoder_init_memory(junk, 3, &decoderConfig, &decoder) == MA_SUCCESS) {
+        printf("    A 3 byte buffer was opened as audio.\n");
+        ma_decoder_uninit(&decoder);
+        hasError = MA_TRUE;
+    }
+
+    if (hasError) {
+        return -1;
+    }
+
+    return 0;
+}
@@ -0,0 +1,227 @@
+/* Once the queue has drained every posted job must show up exactly once in the per-job-type counters and in each histogram. */
+#define STATS_TEST_DIRECTORY    TEST_OUTPUT_DIR"/stats"
+#define STATS_TEST_SMALL_PATH   STATS_TEST_DIRECTORY"/small.wav"
+#define STATS_TEST_BIG_PATH     STATS_TEST_DIRECTORY"/big.wav"
+
+static void test_stats__get(ma_resource_manager* pResourceManager, ma_resource_manager_stats* pStats, ma_uint64* pJobCount, ma_uint64* pExecutedJobCount)
+{
+    ma_uint32 iJobType;
+
+    ma_resource_manager_get_stats(pResourceManager, pStats);
+
+    *pJobCount         = 0;
+    *pExecutedJobCount = 0;
+    for (iJobType = 0; iJobType < MA_JOB_TYPE_COUNT; iJobType += 1) {
+        *pJobCount         += pStats->jobs[iJobType].jobCount;
+        *pExecutedJobCount += pStats->jobs[iJobType].executedJobCount;
+    }
+}
+
+/* Waits until every job that has been posted has been taken out of the queue and processed. */
+static ma_bool32 test_stats__wait_for_jobs(ma_resource_manager* pResourceManager)
+{
+    ma_resource_manager_stats stats;
+    ma_uint64 jobCount;
+    ma_uint64 executedJobCount;
+    ma_uint32 retryCount;
+
+    for (retryCount = 0; retryCount < 10000; retryCount += 1) {
+        test_stats__get(pResourceManager, &stats, &jobCount, &executedJobCount);
+        if (stats.jobQueueDepth == 0 && jobCount == stats.postedJobCount && executedJobCount == jobCount) {
+            return MA_TRUE;
+        }
+
+        test_resource_manager__pump(pResourceManager);
+    }
+
+    return MA_FALSE;
+}
+
+static ma_result test_stats__run(ma_uint32 jobThreadCount)
+{
+    ma_result result;
+    ma_resource_manager_config resourceManagerConfig;
+    ma_resource_manager resourceManager;
+    ma_resource_manager_data_source dataSources[3];
+    ma_resource_manager_data_stream dataStream;
+    ma_resource_manager_stats stats;
+    ma_uint64 jobCount;
+    ma_uint64 executedJobCount;
+    ma_uint64 decodedBytes;
+    ma_uint64 length;
+    ma_uint64 framesRead;
+    ma_uint64 totalFramesRead = 0;
+    ma_uint32 retryCount = 0;
+    ma_uint32 dataSourceCount = 0;
+    ma_uint32 iJobType;
+    ma_uint32 iBucket;
+    float frames[1024 * 2];
+    const char* pErrorMessage = NULL;
+
+    printf("    %u job threads\n", jobThreadCount);
+
+    resourceManagerConfig = test_resource_manager__config_init(jobThreadCount);
+    result = ma_resource_manager_init(&resourceManagerConfig, &resourceManager);
+    if (result != MA_SUCCESS) {
+        return result;
+    }
+
+    test_stats__get(&resourceManager, &stats, &jobCount, &executedJobCount);
+    if (stats.dataBufferLookupCount != 0 || stats.decodedBytes != 0 || stats.postedJobCount != 0 || stats.jobQueueDepth != 0 || jobCount != 0 || stats.streamUnderrunCount != 0) {
+        pErrorMessage = "A new resource manager has non-zero counters.";
+        goto done;
+    }
+
+    /* The first load misses and decodes the whole file. The second finds it and decodes nothing. */
+    if (ma_resource_manager_data_source_init(&resourceManager, STATS_TEST_SMALL_PATH, MA_RESOURCE_MANAGER_DATA_SOURCE_FLAG_DECODE, NULL, &dataSources[dataSourceCount]) != MA_SUCCESS) {
+        pErrorMessage = "Failed to load a file.";
+        goto done;
+    }
+    dataSourceCount += 1;
+
+    ma_resource_manager_data_source_get_length_in_pcm_frames(&dataSources[0], &length);
+    ma_resource_manager_get_stats(&resourceManager, &stats);
+    decodedBytes = stats.decodedBytes;
+
+    if (stats.dataBufferLookupCount != 1 || stats.dataBufferLookupHitCount != 0 || decodedBytes != length * 2 * sizeof(float) ||
+        stats.memoryUsageInBytes != ma_resource_manager_get_memory_usage_in_bytes(&resourceManager)) {
+        pErrorMessage = "Loading a file was not counted correctly.";
+        goto done;
+    }
+
+    if (ma_resource_manager_data_source_init(&resourceManager, STATS_TEST_SMALL_PATH, MA_RESOURCE_MANAGER_DATA_SOURCE_FLAG_DECODE, NULL, &dataSources[dataSourceCount]) != MA_SUCCESS) {
+        pErrorMessage = "Failed to load a file.";
+        goto done;
+    }
+    dataSourceCount += 1;
+
+    ma_resource_manager_get_stats(&resourceManager, &stats);
+    if (stats.dataBufferLookupCount != 2 || stats.dataBufferLookupHitCount != 1 || stats.decodedBytes != decodedBytes) {
+        pErrorMessage = "Loading a file that's already loaded was not counted as a hit.";
+        goto done;
+    }
+
+    /* An asynchronous load goes through the job queue. Without threading loads are always synchronous. */
+    if (jobThreadCount > 0) {
+        if (ma_resource_manager_data_source_init(&resourceManager, STATS_TEST_BIG_PATH, MA_RESOURCE_MANAGER_DATA_SOURCE_FLAG_DECODE | MA_RESOURCE_MANAGER_DATA_SOURCE_FLAG_ASYNC, NULL, &dataSources[dataSourceCount]) != MA_SUCCESS) {
+            pErrorMessage = "Failed to load a file.";
+            goto done;
+        }
+        dataSourceCount += 1;
+
+        if (!test_stats__wait_for_jobs(&resourceManager) || ma_resource_manager_data_source_result(&dataSources[2]) != MA_SUCCESS) {
+            pErrorMessage = "The job counters did not add up to the number of posted jobs.";
+            goto done;
+        }
+
+        ma_resource_manager_get_stats(&resourceManager, &stats);
+        if (stats.postedJobCount == 0 || stats.jobs[MA_JOB_TYPE_RESOURCE_MANAGER_LOAD_DATA_BUFFER_NODE].executedJobCount == 0) {
+            pErrorMessage = "The asynchronous load was not counted.";
+            goto done;
+        }
+    }
+
+    /*
+    Streams refill their pages with jobs as they're read. Without threading nothing processes those jobs until we do, so reading through
+    the pages that were filled when the stream was initialized is guaranteed to run out. Reading again while it's still starved must not
+    count a second underrun.
+    */
+    if (ma_resource_manager_data_stream_init(&resourceManager, STATS_TEST_BIG_PATH, 0, NULL, &dataStream) != MA_SUCCESS) {
+        pErrorMessage = "Failed to initialize a stream.";
+        goto done;
+    }
+
+    while (totalFramesRead < 44100*3 && retryCount < 10000) {
+        if (ma_resource_manager_data_stream_read_pcm_frames(&dataStream, frames, 1024, &framesRead) != MA_SUCCESS || framesRead == 0) {
+            if (jobThreadCount == 0) {
+                break;
+            }
+
+            retryCount += 1;
+            ma_sleep(1);
+        }
+
+        totalFramesRead += framesRead;
+    }
+
+    if (jobThreadCount == 0) {
+        ma_resource_manager_data_stream_read_pcm_frames(&dataStream, frames, 1024, &framesRead);
+        ma_resource_manager_data_stream_read_pcm_frames(&dataStream, frames, 1024, &framesRead);
+
+        ma_resource_manager_get_stats(&resourceManager, &stats);
+        if (totalFramesRead >= 44100*3 || stats.streamUnderrunCount != 1 || ma_resource_manager_data_stream_get_underrun_count(&dataStream) != 1) {
+            ma_resource_manager_data_stream_uninit(&dataStream);
+            pErrorMessage = "A starved stream was not counted as one underrun.";
+            goto done;
+        }
+    }
+
+    if (!test_stats__wait_for_jobs(&resourceManager)) {
+        ma_resource_manager_data_stream_uninit(&dataStream);
+        pErrorMessage = "The job counters did not add up to the number of posted jobs.";
+        goto done;
+    }
+
+    ma_resource_manager_get_stats(&resourceManager, &stats);
+    ma_resource_manager_data_stream_uninit(&dataStream);
+
+    if (stats.jobs[MA_JOB_TYPE_RESOURCE_MANAGER_PAGE_DATA_STREAM].executedJobCount == 0) {
+        pErrorMessage = "The stream's page jobs were not counted.";
+        goto done;
+    }
+
+    /* Every job lands in exactly one bucket of each histogram. */
+    for (iJobType = 0; iJobType < MA_JOB_TYPE_COUNT; iJobType += 1) {
+        ma_uint64 queuedJobCount = 0;
+        ma_uint64 timedJobCount = 0;
+
+        for (iBucket = 0; iBucket < MA_RESOURCE_MANAGER_JOB_LATENCY_BUCKET_COUNT; iBucket += 1) {
+            queuedJobCount += stats.jobs[iJobType].queuedTimeHistogram[iBucket];
+            timedJobCount  += stats.jobs[iJobType].executionTimeHistogram[iBucket];
+        }
+
+        if (queuedJobCount != stats.jobs[iJobType].jobCount || timedJobCount != stats.jobs[iJobType].executedJobCount) {
+            pErrorMessage = "A job latency histogram does not add up to the number of jobs.";
+            goto done;
+        }
+    }
+
+done:
+    while (dataSourceCount > 0) {
+        dataSourceCount -= 1;
+        ma_resource_manager_data_source_uninit(&dataSources[dataSourceCount]);
+    }
+
+    ma_resource_manager_uninit(&resourceManager);
+
+    return test_resource_manager__report(pErrorMessage);
+}
+
+int test_entry__resource_manager_stats(int argc, char** argv)
+{
+    ma_bool32 hasError = MA_FALSE;
+
+    (void)argc;
+    (void)argv;
+
+    if (test_resource_manager__create_directory(STATS_TEST_DIRECTORY) != MA_SUCCESS ||
+        test_resource_manager__write_wav(STATS_TEST_SMALL_PATH, ma_format_s16, 2, 44100, 5000) != MA_SUCCESS ||
+        test_resource_manager__write_wav(STATS_TEST_BIG_PATH,   ma_format_s16, 2, 44100, 44100*5) != MA_SUCCESS) {
+        printf("    Failed to generate test files.\n");
+        return -1;
+    }
+
+    if (test_stats__run(2) != MA_SUCCESS) {
+        hasError = MA_TRUE;
+    }
+
+    if (test_stats__run(0) != MA_SUCCESS) {
+        hasError = MA_TRUE;
+    }
+
+    if (hasError) {
+        return -1;
+    }
+
+    return 0;
+}
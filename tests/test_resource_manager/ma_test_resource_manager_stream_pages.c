@@ -0,0 +1,208 @@
+/*
+Streams keep a ring of pages filled ahead of the reader. When the reader catches up with the job thread it's an underrun, and a stream
+with room to grow adds a page when its cursor next wraps around. However many pages there are and however often the reader runs dry,
+what's streamed has to be exactly what a full decode gives.
+*/
+#define STREAM_PAGES_TEST_DIRECTORY     TEST_OUTPUT_DIR"/stream_pages"
+#define STREAM_PAGES_TEST_WAV_PATH      STREAM_PAGES_TEST_DIRECTORY"/test.wav"
+#define STREAM_PAGES_TEST_CHUNK_SIZE    1000
+
+typedef struct
+{
+    ma_uint32 pageCount;
+    ma_uint32 maxPageCount;
+    ma_uint32 pageSizeInMilliseconds;
+    ma_uint32 jobThreadCount;
+    ma_bool32 starve;           /* When set, jobs are only processed once the reader has run dry. Otherwise every job is processed before each read. */
+    ma_uint32 expectedPageCount;
+} test_stream_pages_case;
+
+static void test_stream_pages__process_all_jobs(ma_resource_manager* pResourceManager)
+{
+    while (ma_resource_manager_process_next_job(pResourceManager) == MA_SUCCESS) {
+    }
+}
+
+static ma_result test_stream_pages__run(const test_stream_pages_case* pCase, const float* pExpectedFrames, ma_uint64 expectedLength, ma_uint32 channels)
+{
+    ma_result result;
+    ma_resource_manager_config resourceManagerConfig;
+    ma_resource_manager resourceManager;
+    ma_resource_manager_data_source_config dataSourceConfig;
+    ma_resource_manager_data_stream dataStream;
+    float* pFrames;
+    ma_uint64 totalFramesRead = 0;
+    ma_uint64 availableFrames;
+    ma_uint64 pageSizeInFrames;
+    ma_uint32 pageCount;
+    ma_uint32 maxPageCount;
+    ma_uint32 underrunCount;
+    ma_uint32 retryCount = 0;
+    const char* pErrorMessage = NULL;
+
+    printf("    %u pages of %u ms, at most %u, %u job threads%s\n", pCase->pageCount, pCase->pageSizeInMilliseconds, pCase->maxPageCount, pCase->jobThreadCount, pCase->starve ? ", starved" : "");
+
+    pFrames = (float*)ma_malloc((size_t)(expectedLength * channels * sizeof(float)), NULL);
+    if (pFrames == NULL) {
+        return MA_OUT_OF_MEMORY;
+    }
+
+    resourceManagerConfig = test_resource_manager__config_init(pCase->jobThreadCount);
+
+    result = ma_resource_manager_init(&resourceManagerConfig, &resourceManager);
+    if (result != MA_SUCCESS) {
+        printf("    Failed to initialize the resource manager.\n");
+        ma_free(pFrames, NULL);
+        return result;
+    }
+
+    dataSourceConfig = ma_resource_manager_data_source_config_init();
+    dataSourceConfig.pFilePath                    = STREAM_PAGES_TEST_WAV_PATH;
+    dataSourceConfig.flags                        = MA_RESOURCE_MANAGER_DATA_SOURCE_FLAG_STREAM;
+    dataSourceConfig.streamPageCount              = pCase->pageCount;
+    dataSourceConfig.streamMaxPageCount           = pCase->maxPageCount;
+    dataSourceConfig.streamPageSizeInMilliseconds = pCase->pageSizeInMilliseconds;
+
+    result = ma_resource_manager_data_stream_init_ex(&resourceManager, &dataSourceConfig, &dataStream);
+    if (result != MA_SUCCESS) {
+        printf("    Failed to initialize the stream.\n");
+        ma_resource_manager_uninit(&resourceManager);
+        ma_free(pFrames, NULL);
+        return result;
+    }
+
+    /* Every page is filled before a synchronous stream is returned, so the configured count and size show up as the available frames. */
+    pageSizeInFrames = pCase->pageSizeInMilliseconds * (dataStream.decoder.outputSampleRate/1000);
+    maxPageCount     = ma_resource_manager_data_stream_get_page_count(&dataStream);
+
+    if (maxPageCount != pCase->pageCount) {
+        pErrorMessage = "The stream did not start with the configured page count.";
+        goto done;
+    }
+
+    if (pCase->jobThreadCount == 0) {
+        ma_resource_manager_data_stream_get_available_frames(&dataStream, &availableFrames);
+        if (availableFrames != pCase->pageCount * pageSizeInFrames) {
+            pErrorMessage = "The pages were not the configured size.";
+            goto done;
+        }
+    }
+
+    while (totalFramesRead < expectedLength && retryCount < 100000) {
+        ma_uint64 framesToRead = ma_min(expectedLength - totalFramesRead, STREAM_PAGES_TEST_CHUNK_SIZE);
+        ma_uint64 framesRead = 0;
+
+        if (pCase->starve == MA_FALSE && pCase->jobThreadCount == 0) {
+            test_stream_pages__process_all_jobs(&resourceManager);
+        }
+
+        result = ma_resource_manager_data_stream_read_pcm_frames(&dataStream, pFrames + totalFramesRead*channels, framesToRead, &framesRead);
+        totalFramesRead += framesRead;
+
+        pageCount = ma_resource_manager_data_stream_get_page_count(&dataStream);
+        if (pageCount > maxPageCount) {
+            maxPageCount = pageCount;
+        }
+
+        if (result == MA_BUSY) {
+            /* The reader has caught up with the decoder. Let only one page through so it runs dry again soon. */
+            if (pCase->jobThreadCount == 0) {
+                ma_resource_manager_process_next_job(&resourceManager);
+            } else {
+                ma_sleep(1);
+            }
+
+            retryCount += 1;
+            continue;
+        }
+
+        if (result != MA_SUCCESS) {
+            break;
+        }
+    }
+
+    if (totalFramesRead != expectedLength || memcmp(pFrames, pExpectedFrames, (size_t)(expectedLength * channels * sizeof(float))) != 0) {
+        pErrorMessage = "The stream read differently to a full decode.";
+        goto done;
+    }
+
+    underrunCount = ma_resource_manager_data_stream_get_underrun_count(&dataStream);
+
+    if (pCase->starve && underrunCount == 0) {
+        pErrorMessage = "Catching up with the decoder was not counted as an underrun.";
+        goto done;
+    }
+
+    if (pCase->starve == MA_FALSE && pCase->jobThreadCount == 0 && underrunCount != 0) {
+        pErrorMessage = "An underrun was counted while the pages were kept filled.";
+        goto done;
+    }
+
+    if (pCase->expectedPageCount != 0 && maxPageCount != pCase->expectedPageCount) {
+        printf("    Expected %u pages, got %u.\n", pCase->expectedPageCount, maxPageCount);
+        pErrorMessage = "The page count did not grow as expected.";
+        goto done;
+    }
+
+    if (maxPageCount > ma_max(pCase->pageCount, pCase->maxPageCount)) {
+        pErrorMessage = "The page count grew past its maximum.";
+        goto done;
+    }
+
+done:
+    ma_resource_manager_data_stream_uninit(&dataStream);
+    ma_resource_manager_uninit(&resourceManager);
+    ma_free(pFrames, NULL);
+
+    return test_resource_manager__report(pErrorMessage);
+}
+
+int test_entry__resource_manager_stream_pages(int argc, char** argv)
+{
+    /*
+    An expected page count of 0 means it isn't checked. With a job thread, whether or not the reader gets ahead of it is up to the
+    scheduler so only the audio is checked.
+    */
+    static const test_stream_pages_case cases[] = {
+        { 2, 0,  100, 0, MA_FALSE, 2 },     /* Kept filled. No underruns and no growth. */
+        { 4, 0,   50, 0, MA_FALSE, 4 },
+        { 2, 0,  100, 0, MA_TRUE,  2 },     /* Underruns without room to grow. */
+        { 2, 6,  100, 0, MA_TRUE,  6 },     /* Underruns grow the ring one page at a time up to the maximum. */
+        { 3, 16,  20, 0, MA_TRUE,  16 },
+        { 2, 8,   20, 1, MA_FALSE, 0 }
+    };
+    ma_bool32 hasError = MA_FALSE;
+    float* pExpectedFrames;
+    ma_uint64 expectedLength;
+    ma_uint32 channels;
+    size_t iCase;
+
+    (void)argc;
+    (void)argv;
+
+    /* Long enough to wrap around even the largest ring plenty of times. */
+    if (test_resource_manager__create_directory(STREAM_PAGES_TEST_DIRECTORY) != MA_SUCCESS ||
+        test_resource_manager__write_wav(STREAM_PAGES_TEST_WAV_PATH, ma_format_s16, 2, 44100, 44100*10 + 123) != MA_SUCCESS) {
+        printf("    Failed to generate test files.\n");
+        return -1;
+    }
+
+    if (test_resource_manager__decode_file(STREAM_PAGES_TEST_WAV_PATH, 0, &pExpectedFrames, &expectedLength, &channels) != MA_SUCCESS) {
+        printf("    Failed to decode the reference.\n");
+        return -1;
+    }
+
+    for (iCase = 0; iCase < ma_countof(cases); iCase += 1) {
+        if (test_stream_pages__run(&cases[iCase], pExpectedFrames, expectedLength, channels) != MA_SUCCESS) {
+            hasError = MA_TRUE;
+        }
+    }
+
+    ma_free(pExpectedFrames, NULL);
+
+    if (hasError) {
+        return -1;
+    }
+
+    return 0;
+}
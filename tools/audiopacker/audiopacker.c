@@ -0,0 +1,152 @@
+/*
+USAGE: audiopacker [output file] [input files...] [--align alignment]
+
+Packs a set of files into a single archive which can be opened with ma_pak_vfs. Files are stored under the name they were given on the
+command line with backslashes replaced with forward slashes. Pass the same names to the resource manager to load them out of the
+archive.
+
+EXAMPLES:
+    audiopacker sounds.pak sfx/jump.wav sfx/land.wav music/theme.flac
+    audiopacker sounds.pak sfx/jump.wav sfx/land.wav --align 4096
+*/
+
+#define MA_NO_DEVICE_IO
+#define MA_NO_THREADING
+#define MINIAUDIO_IMPLEMENTATION
+#include "../../miniaudio.h"
+
+#include <stdio.h>
+
+void print_usage()
+{
+    printf("USAGE: audiopacker [output file] [input files...] [--align alignment]\n");
+    printf("\n");
+    printf("PARAMETERS:\n");
+    printf("  --align [1..65536] Aligns the data of each file. Must be a power of two. Defaults to 16.\n");
+    printf("                     Use the page size (4096) if files will be memory mapped by another process.\n");
+}
+
+ma_bool32 is_number(const char* str)
+{
+    if (str == NULL || str[0] == '\0') {
+        return MA_FALSE;
+    }
+
+    while (str[0] != '\0') {
+        if (str[0] < '0' || str[0] > '9') {
+            return MA_FALSE;
+        }
+
+        str += 1;
+    }
+
+    return MA_TRUE;
+}
+
+ma_uint32 get_encoding_format(const char* pFilePath)
+{
+    if (ma_path_extension_equal(pFilePath, "wav")) {
+        return ma_encoding_format_wav;
+    }
+    if (ma_path_extension_equal(pFilePath, "flac")) {
+        return ma_encoding_format_flac;
+    }
+    if (ma_path_extension_equal(pFilePath, "mp3")) {
+        return ma_encoding_format_mp3;
+    }
+    if (ma_path_extension_equal(pFilePath, "ogg")) {
+        return ma_encoding_format_vorbis;
+    }
+
+    return ma_encoding_format_unknown;
+}
+
+int main(int argc, char** argv)
+{
+    ma_result result;
+    ma_default_vfs vfs;
+    const char* pOutputFilePath;
+    ma_pak_write_entry* pEntries;
+    ma_uint32 entryCount = 0;
+    ma_uint32 alignment = 16;
+    int exitCode = -1;
+    int iarg;
+
+    /* Print help if requested. */
+    if (argc == 2) {
+        if (strcmp(argv[1], "-h") == 0 || strcmp(argv[1], "--help") == 0) {
+            print_usage();
+            return 0;
+        }
+    }
+
+    if (argc < 3) {
+        print_usage();
+        return -1;
+    }
+
+    pOutputFilePath = argv[1];
+
+    pEntries = (ma_pak_write_entry*)ma_calloc(sizeof(*pEntries) * (size_t)argc, NULL);
+    if (pEntries == NULL) {
+        printf("Out of memory.\n");
+        return -1;
+    }
+
+    ma_default_vfs_init(&vfs, NULL);
+
+    for (iarg = 2; iarg < argc; iarg += 1) {
+        ma_pak_write_entry* pEntry;
+        ma_vfs_file file;
+
+        if (strcmp(argv[iarg], "--align") == 0) {
+            iarg += 1;
+            if (iarg >= argc || !is_number(argv[iarg]) || atoi(argv[iarg]) < 1 || atoi(argv[iarg]) > 65536 || (atoi(argv[iarg]) & (atoi(argv[iarg]) - 1)) != 0) {
+                printf("Expecting a power of two between 1 and 65536 for --align.\n");
+                goto done;
+            }
+
+            alignment = (ma_uint32)atoi(argv[iarg]);
+            continue;
+        }
+
+        /* The name is the path as given. ma_pak_write_file() normalizes the slashes. */
+        pEntry = &pEntries[entryCount];
+        pEntry->pName          = argv[iarg];
+        pEntry->pFilePath      = argv[iarg];
+        pEntry->encodingFormat = get_encoding_format(argv[iarg]);
+
+        /* Check each file up front so the error can say which one is the problem. */
+        result = ma_vfs_open(&vfs, pEntry->pFilePath, MA_OPEN_MODE_READ, &file);
+        if (result != MA_SUCCESS) {
+            printf("Failed to open \"%s\". %s\n", pEntry->pFilePath, ma_result_description(result));
+            goto done;
+        }
+
+        ma_vfs_close(&vfs, file);
+
+        if (pEntry->encodingFormat == ma_encoding_format_unknown) {
+            printf("Warning: Unknown file extension \"%s\". The file will be stored with an unknown encoding format.\n", ma_path_extension(pEntry->pFilePath));
+        }
+
+        entryCount += 1;
+    }
+
+    result = ma_pak_write_file((ma_vfs*)&vfs, pOutputFilePath, pEntries, entryCount, alignment, NULL);
+    if (result == MA_ALREADY_EXISTS) {
+        printf("The same file was given more than once.\n");
+        goto done;
+    }
+
+    if (result != MA_SUCCESS) {
+        printf("Failed to write output file. %s\n", ma_result_description(result));
+        goto done;
+    }
+
+    printf("Packed %u files into \"%s\".\n", (unsigned int)entryCount, pOutputFilePath);
+    exitCode = 0;
+
+done:
+    ma_free(pEntries, NULL);
+    return exitCode;
+}